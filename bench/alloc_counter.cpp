@@ -0,0 +1,126 @@
+// Replaces the global allocation functions of the benchmark binary so that
+// every heap allocation made by a benchmark body is counted.
+
+#include "harness.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> alloc_count{0};
+std::atomic<std::uint64_t> alloc_bytes{0};
+
+void* CountedAlloc(std::size_t size) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* CountedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t alignment = std::max(static_cast<std::size_t>(align), sizeof(void*));
+    std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    if (rounded == 0) {
+        rounded = alignment;
+    }
+    while (true) {
+        if (void* ptr = std::aligned_alloc(alignment, rounded)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+}  // namespace
+
+namespace bench {
+
+AllocStats CurrentAllocStats() {
+    return {alloc_count.load(std::memory_order_relaxed), alloc_bytes.load(std::memory_order_relaxed)};
+}
+
+}  // namespace bench
+
+void* operator new(std::size_t size) {
+    return CountedAlloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return CountedAlloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAlloc(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAlloc(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return CountedAlignedAlloc(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return CountedAlignedAlloc(size, align);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
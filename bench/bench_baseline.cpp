@@ -0,0 +1,39 @@
+// Reference points the assignment solutions are compared against.
+
+#include "harness.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint64_t> RandomKeys(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<std::uint64_t> keys(n);
+    for (auto& key : keys) {
+        key = gen();
+    }
+    return keys;
+}
+
+BENCHMARK("baseline/std_sort_u64", [](bench::State& state) {
+    auto keys = RandomKeys(state.N(), 1);
+    state.ResumeTiming();
+    std::sort(keys.begin(), keys.end());
+    state.PauseTiming();
+    bench::DoNotOptimize(keys.data());
+});
+
+BENCHMARK("baseline/vector_push_back", [](bench::State& state) {
+    state.ResumeTiming();
+    std::vector<std::uint64_t> values;
+    for (std::size_t i = 0; i < state.N(); ++i) {
+        values.push_back(i);
+    }
+    bench::DoNotOptimize(values.data());
+    state.PauseTiming();
+});
+
+}  // namespace
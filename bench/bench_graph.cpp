@@ -0,0 +1,225 @@
+#include "harness.h"
+
+#include <aisd/graph/bfs.h>
+#include <aisd/graph/boruvka_mst.h>
+#include <aisd/graph/csr_graph.h>
+#include <aisd/graph/delta_stepping.h>
+#include <aisd/graph/edge_list.h>
+#include <aisd/graph/union_find.h>
+#include <aisd/heap/d_ary_heap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+// Uniform random multigraph with n vertices and 8n edges, weights in
+// [1, 256): low diameter, so the BFS spends its time in a few huge levels.
+std::vector<aisd::Edge<>> RandomEdges(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<aisd::Edge<>> edges(8 * n);
+    for (auto& edge : edges) {
+        edge.from = static_cast<aisd::VertexId>(gen() % n);
+        edge.to = static_cast<aisd::VertexId>(gen() % n);
+        edge.weight = static_cast<std::uint32_t>(1 + gen() % 255);
+    }
+    return edges;
+}
+
+aisd::CsrGraph<> RandomGraph(std::size_t n) {
+    return aisd::CsrGraph<>::FromEdges(static_cast<aisd::VertexId>(n), RandomEdges(n, 1), true);
+}
+
+// Textbook vector-of-vectors adjacency, the representation CSR replaces.
+std::vector<std::vector<std::pair<aisd::VertexId, std::uint32_t>>> AdjacencyLists(std::size_t n) {
+    std::vector<std::vector<std::pair<aisd::VertexId, std::uint32_t>>> adjacency(n);
+    for (const auto& edge : RandomEdges(n, 1)) {
+        adjacency[edge.from].emplace_back(edge.to, edge.weight);
+        if (edge.from != edge.to) {
+            adjacency[edge.to].emplace_back(edge.from, edge.weight);
+        }
+    }
+    return adjacency;
+}
+
+// Ops are arcs for every graph benchmark.
+BENCHMARK(
+    "graph/build/adjacency_lists",
+    [](bench::State& state) {
+        auto edges = RandomEdges(state.N(), 1);
+        state.SetOps(2 * edges.size());
+        state.ResumeTiming();
+        std::vector<std::vector<std::pair<aisd::VertexId, std::uint32_t>>> adjacency(state.N());
+        for (const auto& edge : edges) {
+            adjacency[edge.from].emplace_back(edge.to, edge.weight);
+            if (edge.from != edge.to) {
+                adjacency[edge.to].emplace_back(edge.from, edge.weight);
+            }
+        }
+        state.PauseTiming();
+        bench::DoNotOptimize(adjacency.data());
+    },
+    1'000'000);
+BENCHMARK(
+    "graph/build/csr",
+    [](bench::State& state) {
+        auto edges = RandomEdges(state.N(), 1);
+        state.SetOps(2 * edges.size());
+        state.ResumeTiming();
+        auto graph = aisd::CsrGraph<>::FromEdges(static_cast<aisd::VertexId>(state.N()), edges, true);
+        state.PauseTiming();
+        bench::DoNotOptimize(graph.Targets().data());
+    },
+    1'000'000);
+BENCHMARK(
+    "graph/build/load_edge_list",
+    [](bench::State& state) {
+        // Per-process name: concurrent bench runs must not share the file.
+        auto name = "aisd_bench_edges." + std::to_string(::getpid()) + ".bin";
+        auto path = (std::filesystem::temp_directory_path() / name).string();
+        auto edges = RandomEdges(state.N(), 1);
+        aisd::SaveEdgeList(path, edges, true);
+        state.SetOps(2 * edges.size());
+        edges = {};
+        state.ResumeTiming();
+        auto graph = aisd::LoadEdgeList<>(path, true, true);
+        state.PauseTiming();
+        bench::DoNotOptimize(graph.Targets().data());
+        std::filesystem::remove(path);
+    },
+    1'000'000);
+
+BENCHMARK(
+    "graph/bfs/adjacency_lists_queue",
+    [](bench::State& state) {
+        auto adjacency = AdjacencyLists(state.N());
+        std::vector<std::uint32_t> depth(state.N(), aisd::kUnreachedDepth);
+        std::queue<aisd::VertexId> queue;
+        state.ResumeTiming();
+        depth[0] = 0;
+        queue.push(0);
+        while (!queue.empty()) {
+            aisd::VertexId u = queue.front();
+            queue.pop();
+            for (auto [v, weight] : adjacency[u]) {
+                if (depth[v] == aisd::kUnreachedDepth) {
+                    depth[v] = depth[u] + 1;
+                    queue.push(v);
+                }
+            }
+        }
+        state.PauseTiming();
+        state.SetOps(16 * state.N());
+        bench::DoNotOptimize(depth.data());
+    },
+    1'000'000);
+BENCHMARK(
+    "graph/bfs/direction_optimizing",
+    [](bench::State& state) {
+        auto graph = RandomGraph(state.N());
+        state.SetOps(graph.ArcCount());
+        state.ResumeTiming();
+        auto depth = aisd::Bfs(graph, 0);
+        state.PauseTiming();
+        bench::DoNotOptimize(depth.data());
+    },
+    1'000'000);
+
+BENCHMARK(
+    "graph/sssp/dijkstra_d_ary_heap",
+    [](bench::State& state) {
+        auto graph = RandomGraph(state.N());
+        state.SetOps(graph.ArcCount());
+        state.ResumeTiming();
+        std::vector<std::uint64_t> distance(state.N(), aisd::kUnreachedDistance);
+        std::vector<aisd::HeapHandle> handle(state.N(), aisd::kInvalidHeapHandle);
+        aisd::DAryHeap<std::pair<std::uint64_t, aisd::VertexId>> heap;
+        distance[0] = 0;
+        heap.Push({0, 0});
+        while (!heap.Empty()) {
+            auto [du, u] = heap.Top();
+            heap.Pop();
+            handle[u] = aisd::kInvalidHeapHandle;
+            auto neighbors = graph.Neighbors(u);
+            auto weights = graph.NeighborWeights(u);
+            for (std::size_t i = 0; i < neighbors.size(); ++i) {
+                aisd::VertexId v = neighbors[i];
+                std::uint64_t candidate = du + weights[i];
+                if (candidate >= distance[v]) {
+                    continue;
+                }
+                distance[v] = candidate;
+                if (handle[v] != aisd::kInvalidHeapHandle) {
+                    heap.DecreaseKey(handle[v], {candidate, v});
+                } else {
+                    handle[v] = heap.Push({candidate, v});
+                }
+            }
+        }
+        state.PauseTiming();
+        bench::DoNotOptimize(distance.data());
+    },
+    1'000'000);
+BENCHMARK(
+    "graph/sssp/delta_stepping",
+    [](bench::State& state) {
+        auto graph = RandomGraph(state.N());
+        state.SetOps(graph.ArcCount());
+        state.ResumeTiming();
+        auto distance = aisd::DeltaStepping(graph, 0);
+        state.PauseTiming();
+        bench::DoNotOptimize(distance.data());
+    },
+    1'000'000);
+
+BENCHMARK(
+    "graph/mst/kruskal",
+    [](bench::State& state) {
+        auto edges = RandomEdges(state.N(), 1);
+        state.SetOps(2 * edges.size());
+        state.ResumeTiming();
+        std::sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) { return a.weight < b.weight; });
+        aisd::UnionFind components(state.N());
+        std::uint64_t total = 0;
+        for (const auto& edge : edges) {
+            if (components.Union(edge.from, edge.to)) {
+                total += edge.weight;
+            }
+        }
+        state.PauseTiming();
+        bench::DoNotOptimize(total);
+    },
+    1'000'000);
+BENCHMARK(
+    "graph/mst/boruvka",
+    [](bench::State& state) {
+        auto graph = RandomGraph(state.N());
+        state.SetOps(graph.ArcCount());
+        state.ResumeTiming();
+        auto forest = aisd::BoruvkaMst(graph);
+        state.PauseTiming();
+        bench::DoNotOptimize(forest.data());
+    },
+    1'000'000);
+BENCHMARK(
+    "graph/mst/boruvka_sorted_rows",
+    [](bench::State& state) {
+        auto graph = RandomGraph(state.N());
+        graph.SortNeighbors();
+        state.SetOps(graph.ArcCount());
+        state.ResumeTiming();
+        auto forest = aisd::BoruvkaMst(graph);
+        state.PauseTiming();
+        bench::DoNotOptimize(forest.data());
+    },
+    1'000'000);
+
+}  // namespace
@@ -0,0 +1,106 @@
+#include "harness.h"
+
+#include <aisd/hash/robin_hood_map.h>
+#include <aisd/hash/string_arena.h>
+#include <aisd/hash/swiss_table.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint64_t> RandomKeys(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<std::uint64_t> keys(n);
+    for (auto& key : keys) {
+        key = gen();
+    }
+    return keys;
+}
+
+// n inserts, then n lookups of which half hit.
+template <class Map>
+void InsertLookup(bench::State& state, Map map) {
+    auto keys = RandomKeys(state.N(), 1);
+    auto misses = RandomKeys(state.N() / 2, 2);
+    std::vector<std::uint64_t> queries(keys.begin(), keys.begin() + (state.N() - misses.size()));
+    queries.insert(queries.end(), misses.begin(), misses.end());
+    std::shuffle(queries.begin(), queries.end(), std::mt19937(3));
+    std::uint64_t found = 0;
+    state.SetOps(2 * state.N());
+    state.ResumeTiming();
+    for (auto key : keys) {
+        map.Insert(key, key);
+    }
+    for (auto key : queries) {
+        found += map.Contains(key);
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(found);
+}
+
+struct StdUnorderedMap {
+    void Insert(std::uint64_t key, std::uint64_t value) {
+        map.emplace(key, value);
+    }
+    bool Contains(std::uint64_t key) const {
+        return map.count(key) != 0;
+    }
+
+    std::unordered_map<std::uint64_t, std::uint64_t> map;
+};
+
+using Swiss = aisd::FlatHashMap<std::uint64_t, std::uint64_t>;
+using RobinHood = aisd::RobinHoodMap<std::uint64_t, std::uint64_t>;
+
+BENCHMARK("hash/u64/std_unordered_map", [](bench::State& state) { InsertLookup(state, StdUnorderedMap()); });
+BENCHMARK("hash/u64/swiss", [](bench::State& state) { InsertLookup(state, Swiss()); });
+BENCHMARK("hash/u64/swiss_compact",
+          [](bench::State& state) { InsertLookup(state, Swiss(Swiss::kCompactMaxLoadFactor)); });
+BENCHMARK("hash/u64/robin_hood", [](bench::State& state) { InsertLookup(state, RobinHood()); });
+BENCHMARK("hash/u64/robin_hood_compact",
+          [](bench::State& state) { InsertLookup(state, RobinHood(RobinHood::kCompactMaxLoadFactor)); });
+
+// Dedup of n lines drawn from n / 4 distinct values.
+std::vector<std::string> RandomLines(std::size_t n) {
+    std::mt19937_64 gen(4);
+    std::vector<std::string> lines(n);
+    for (auto& line : lines) {
+        line = "user-" + std::to_string(gen() % (n / 4 + 1)) + "/session";
+    }
+    return lines;
+}
+
+BENCHMARK(
+    "hash/dedup/std_unordered_set",
+    [](bench::State& state) {
+        auto lines = RandomLines(state.N());
+        state.ResumeTiming();
+        std::unordered_set<std::string> set;
+        for (const auto& line : lines) {
+            set.insert(line);
+        }
+        state.PauseTiming();
+        bench::DoNotOptimize(set.size());
+    },
+    1'000'000);
+BENCHMARK(
+    "hash/dedup/arena_string_set",
+    [](bench::State& state) {
+        auto lines = RandomLines(state.N());
+        state.ResumeTiming();
+        aisd::ArenaStringSet<> set;
+        for (const auto& line : lines) {
+            set.Insert(line);
+        }
+        state.PauseTiming();
+        bench::DoNotOptimize(set.Size());
+    },
+    1'000'000);
+
+}  // namespace
@@ -0,0 +1,116 @@
+#include "harness.h"
+
+#include <aisd/heap/d_ary_heap.h>
+#include <aisd/heap/pairing_heap.h>
+#include <aisd/heap/radix_heap.h>
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint32_t> RandomKeys(std::size_t n, std::uint64_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<std::uint32_t> keys(n);
+    for (auto& key : keys) {
+        key = gen();
+    }
+    return keys;
+}
+
+// n pushes followed by n pops.
+template <class Heap>
+void PushPop(bench::State& state) {
+    auto keys = RandomKeys(state.N(), 1);
+    Heap heap;
+    heap.Reserve(state.N());
+    state.SetOps(2 * state.N());
+    state.ResumeTiming();
+    for (auto key : keys) {
+        heap.Push(key);
+    }
+    std::uint64_t sum = 0;
+    while (!heap.Empty()) {
+        sum += heap.Top();
+        heap.Pop();
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(sum);
+}
+
+// Shortest-path-like mix: n pushes, n decrease-keys, n pops.
+template <class Heap>
+void DecreaseKeyMix(bench::State& state) {
+    std::size_t n = state.N();
+    auto keys = RandomKeys(n, 2);
+    std::mt19937 gen(3);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> updates(n);
+    for (auto& [index, fraction] : updates) {
+        index = gen() % n;
+        fraction = gen() % 4 + 1;
+    }
+    Heap heap;
+    heap.Reserve(n);
+    std::vector<aisd::HeapHandle> handles(n);
+    state.SetOps(3 * n);
+    state.ResumeTiming();
+    for (std::size_t i = 0; i < n; ++i) {
+        handles[i] = heap.Push(keys[i]);
+    }
+    for (auto [index, fraction] : updates) {
+        std::uint32_t key = heap.KeyOf(handles[index]);
+        heap.DecreaseKey(handles[index], key - key / (fraction + 1));
+    }
+    std::uint64_t sum = 0;
+    while (!heap.Empty()) {
+        sum += heap.Top();
+        heap.Pop();
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(sum);
+}
+
+// std::priority_queue has no Reserve/Top/Pop in this spelling.
+struct StdPriorityQueue {
+    void Reserve(std::size_t capacity) {
+        std::vector<std::uint32_t> storage;
+        storage.reserve(capacity);
+        queue = decltype(queue)(std::greater<>(), std::move(storage));
+    }
+    void Push(std::uint32_t key) {
+        queue.push(key);
+    }
+    std::uint32_t Top() const {
+        return queue.top();
+    }
+    void Pop() {
+        queue.pop();
+    }
+    bool Empty() const {
+        return queue.empty();
+    }
+
+    std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<>> queue;
+};
+
+using Binary = aisd::DAryHeap<std::uint32_t, 2>;
+using Quaternary = aisd::DAryHeap<std::uint32_t, 4>;
+using Octonary = aisd::DAryHeap<std::uint32_t, 8>;
+using Pairing = aisd::PairingHeap<std::uint32_t>;
+using Radix = aisd::RadixHeap<std::uint32_t>;
+
+BENCHMARK("heap/push_pop/std_priority_queue", PushPop<StdPriorityQueue>);
+BENCHMARK("heap/push_pop/d_ary_2", PushPop<Binary>);
+BENCHMARK("heap/push_pop/d_ary_4", PushPop<Quaternary>);
+BENCHMARK("heap/push_pop/d_ary_8", PushPop<Octonary>);
+BENCHMARK("heap/push_pop/pairing", PushPop<Pairing>);
+BENCHMARK("heap/push_pop/radix", PushPop<Radix>);
+
+BENCHMARK("heap/decrease_key/d_ary_4", DecreaseKeyMix<Quaternary>);
+BENCHMARK("heap/decrease_key/pairing", DecreaseKeyMix<Pairing>);
+BENCHMARK("heap/decrease_key/radix", DecreaseKeyMix<Radix>);
+
+}  // namespace
@@ -0,0 +1,81 @@
+#include "harness.h"
+
+#include <aisd/sort/sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint64_t> RandomKeys(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<std::uint64_t> keys(n);
+    for (auto& key : keys) {
+        key = gen();
+    }
+    return keys;
+}
+
+std::vector<std::string> RandomWords(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<std::string> words(n);
+    for (auto& word : words) {
+        std::size_t length = 4 + gen() % 16;
+        for (std::size_t i = 0; i < length; ++i) {
+            word.push_back(static_cast<char>('a' + gen() % 26));
+        }
+    }
+    return words;
+}
+
+template <class Key, class SortFn>
+void SortBench(bench::State& state, std::vector<Key> (*generate)(std::size_t, std::uint64_t), SortFn sort) {
+    auto keys = generate(state.N(), 1);
+    state.ResumeTiming();
+    sort(keys);
+    state.PauseTiming();
+    bench::DoNotOptimize(keys.data());
+}
+
+template <class Key>
+void StdSort(std::vector<Key>& keys) {
+    std::sort(keys.begin(), keys.end());
+}
+
+BENCHMARK("sort/u64/std_sort",
+          [](bench::State& state) { SortBench(state, RandomKeys, StdSort<std::uint64_t>); });
+BENCHMARK("sort/u64/block_quicksort", [](bench::State& state) {
+    SortBench(state, RandomKeys, [](auto& keys) { aisd::BlockQuicksort(keys.begin(), keys.end()); });
+});
+BENCHMARK("sort/u64/lsd_radix", [](bench::State& state) {
+    SortBench(state, RandomKeys, [](auto& keys) { aisd::LsdRadixSort(keys.data(), keys.data() + keys.size()); });
+});
+BENCHMARK("sort/u64/multiway_merge", [](bench::State& state) {
+    SortBench(state, RandomKeys,
+              [](auto& keys) { aisd::ParallelMultiwayMergeSort(keys.begin(), keys.end(), std::less<>()); });
+});
+BENCHMARK("sort/u64/sort", [](bench::State& state) {
+    SortBench(state, RandomKeys, [](auto& keys) { aisd::Sort(keys.begin(), keys.end()); });
+});
+
+BENCHMARK(
+    "sort/string/std_sort",
+    [](bench::State& state) { SortBench(state, RandomWords, StdSort<std::string>); }, 1'000'000);
+BENCHMARK(
+    "sort/string/msd_radix",
+    [](bench::State& state) {
+        SortBench(state, RandomWords,
+                  [](auto& words) { aisd::MsdRadixSort(words.data(), words.data() + words.size()); });
+    },
+    1'000'000);
+BENCHMARK(
+    "sort/string/sort",
+    [](bench::State& state) {
+        SortBench(state, RandomWords, [](auto& words) { aisd::Sort(words.begin(), words.end()); });
+    },
+    1'000'000);
+
+}  // namespace
@@ -0,0 +1,130 @@
+#include "harness.h"
+
+#include <aisd/string/aho_corasick.h>
+#include <aisd/string/string_search.h>
+#include <aisd/string/suffix_array.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Text over a small alphabet, so that suffixes share long prefixes and
+// patterns actually occur.
+std::string RandomText(std::size_t n, std::size_t alphabet, std::uint64_t seed) {
+    std::mt19937 gen(seed);
+    std::string text(n, 'a');
+    for (auto& ch : text) {
+        ch = static_cast<char>('a' + gen() % alphabet);
+    }
+    return text;
+}
+
+std::vector<std::string> RandomPatterns(std::size_t count, std::size_t alphabet, std::uint64_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<std::string> patterns(count);
+    for (auto& pattern : patterns) {
+        pattern = RandomText(4 + gen() % 8, alphabet, gen());
+    }
+    return patterns;
+}
+
+BENCHMARK(
+    "string/suffix_array/std_sort",
+    [](bench::State& state) {
+        auto text = RandomText(state.N(), 4, 1);
+        std::string_view view = text;
+        std::vector<std::int32_t> sa(text.size());
+        state.ResumeTiming();
+        for (std::size_t i = 0; i < sa.size(); ++i) {
+            sa[i] = static_cast<std::int32_t>(i);
+        }
+        std::sort(sa.begin(), sa.end(), [view](std::int32_t a, std::int32_t b) {
+            return view.substr(static_cast<std::size_t>(a)) < view.substr(static_cast<std::size_t>(b));
+        });
+        state.PauseTiming();
+        bench::DoNotOptimize(sa.data());
+    },
+    1'000'000);
+BENCHMARK("string/suffix_array/sa_is", [](bench::State& state) {
+    auto text = RandomText(state.N(), 4, 1);
+    state.ResumeTiming();
+    auto sa = aisd::SuffixArray(text);
+    state.PauseTiming();
+    bench::DoNotOptimize(sa.data());
+});
+BENCHMARK("string/suffix_array/sa_is_repetitive", [](bench::State& state) {
+    auto text = RandomText(state.N(), 1, 1);
+    state.ResumeTiming();
+    auto sa = aisd::SuffixArray(text);
+    state.PauseTiming();
+    bench::DoNotOptimize(sa.data());
+});
+BENCHMARK("string/lcp/phi", [](bench::State& state) {
+    auto text = RandomText(state.N(), 4, 1);
+    auto sa = aisd::SuffixArray(text);
+    state.ResumeTiming();
+    auto lcp = aisd::LcpArray(text, sa);
+    state.PauseTiming();
+    bench::DoNotOptimize(lcp.data());
+});
+
+// n bytes searched for 100 patterns; ops are text bytes.
+BENCHMARK("string/multi_search/naive_find", [](bench::State& state) {
+    auto text = RandomText(state.N(), 16, 1);
+    auto patterns = RandomPatterns(100, 16, 2);
+    std::uint64_t matches = 0;
+    state.ResumeTiming();
+    for (const auto& pattern : patterns) {
+        for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++matches;
+        }
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(matches);
+});
+BENCHMARK("string/multi_search/aho_corasick", [](bench::State& state) {
+    auto text = RandomText(state.N(), 16, 1);
+    aisd::AhoCorasick automaton;
+    for (const auto& pattern : RandomPatterns(100, 16, 2)) {
+        automaton.AddPattern(pattern);
+    }
+    automaton.Build();
+    std::uint64_t matches = 0;
+    state.ResumeTiming();
+    automaton.Scan(text, [&](std::size_t, std::size_t) { ++matches; });
+    state.PauseTiming();
+    bench::DoNotOptimize(matches);
+});
+
+BENCHMARK("string/search/std_boyer_moore_horspool", [](bench::State& state) {
+    auto text = RandomText(state.N(), 4, 1);
+    auto pattern = RandomText(12, 4, 2);
+    std::boyer_moore_horspool_searcher searcher(pattern.begin(), pattern.end());
+    std::uint64_t matches = 0;
+    state.ResumeTiming();
+    for (auto it = text.begin();; ++it) {
+        it = std::search(it, text.end(), searcher);
+        if (it == text.end()) {
+            break;
+        }
+        ++matches;
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(matches);
+});
+BENCHMARK("string/search/kmp", [](bench::State& state) {
+    auto text = RandomText(state.N(), 4, 1);
+    auto pattern = RandomText(12, 4, 2);
+    state.ResumeTiming();
+    auto matches = aisd::FindAll(text, pattern);
+    state.PauseTiming();
+    bench::DoNotOptimize(matches.data());
+});
+
+}  // namespace
@@ -0,0 +1,128 @@
+#include "harness.h"
+
+#include <aisd/tree/btree_set.h>
+#include <aisd/tree/eytzinger_set.h>
+#include <aisd/tree/fenwick_tree.h>
+#include <aisd/tree/segment_tree.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint32_t> RandomKeys(std::size_t n, std::uint64_t seed) {
+    std::mt19937 gen(seed);
+    std::vector<std::uint32_t> keys(n);
+    for (auto& key : keys) {
+        key = gen();
+    }
+    return keys;
+}
+
+// n random lookups into a set of n keys; lookup(key) returns something
+// summable so the queries cannot be dropped.
+template <class Build, class Lookup>
+void LookupBench(bench::State& state, Build build, Lookup lookup) {
+    auto keys = RandomKeys(state.N(), 1);
+    auto queries = RandomKeys(state.N(), 2);
+    auto index = build(keys);
+    std::uint64_t sum = 0;
+    state.ResumeTiming();
+    for (auto query : queries) {
+        sum += lookup(index, query);
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(sum);
+}
+
+BENCHMARK("tree/lookup/std_set", [](bench::State& state) {
+    LookupBench(
+        state, [](const auto& keys) { return std::set<std::uint32_t>(keys.begin(), keys.end()); },
+        [](const auto& set, std::uint32_t key) { return set.count(key); });
+});
+BENCHMARK("tree/lookup/sorted_vector", [](bench::State& state) {
+    LookupBench(
+        state,
+        [](auto keys) {
+            std::sort(keys.begin(), keys.end());
+            return keys;
+        },
+        [](const auto& keys, std::uint32_t key) {
+            return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        });
+});
+BENCHMARK("tree/lookup/eytzinger_rank", [](bench::State& state) {
+    LookupBench(
+        state, [](const auto& keys) { return aisd::EytzingerSet<std::uint32_t>(keys); },
+        [](const auto& set, std::uint32_t key) { return set.Rank(key); });
+});
+BENCHMARK("tree/lookup/btree_rank", [](bench::State& state) {
+    LookupBench(
+        state,
+        [](const auto& keys) {
+            aisd::BTreeSet<std::uint32_t> set;
+            for (auto key : keys) {
+                set.Insert(key);
+            }
+            return set;
+        },
+        [](const auto& set, std::uint32_t key) { return set.Rank(key); });
+});
+
+BENCHMARK("tree/insert/std_set", [](bench::State& state) {
+    auto keys = RandomKeys(state.N(), 1);
+    state.ResumeTiming();
+    std::set<std::uint32_t> set;
+    for (auto key : keys) {
+        set.insert(key);
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(set.size());
+});
+BENCHMARK("tree/insert/btree", [](bench::State& state) {
+    auto keys = RandomKeys(state.N(), 1);
+    state.ResumeTiming();
+    aisd::BTreeSet<std::uint32_t> set;
+    for (auto key : keys) {
+        set.Insert(key);
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(set.Size());
+});
+
+// n point updates interleaved with n range queries.
+template <class Index>
+void RangeQueryBench(bench::State& state) {
+    std::size_t n = state.N();
+    auto values = RandomKeys(n, 1);
+    auto positions = RandomKeys(2 * n, 2);
+    Index index(std::vector<std::uint64_t>(values.begin(), values.end()));
+    std::uint64_t sum = 0;
+    state.SetOps(2 * n);
+    state.ResumeTiming();
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t a = positions[2 * i] % n;
+        std::size_t b = positions[2 * i + 1] % n;
+        if (a > b) {
+            std::swap(a, b);
+        }
+        if constexpr (std::is_same_v<Index, aisd::FenwickTree<std::uint64_t>>) {
+            index.Add(a, 1);
+            sum += index.RangeSum(a, b + 1);
+        } else {
+            index.Set(a, values[b]);
+            sum += index.Query(a, b + 1);
+        }
+    }
+    state.PauseTiming();
+    bench::DoNotOptimize(sum);
+}
+
+BENCHMARK("tree/range/fenwick_sum", RangeQueryBench<aisd::FenwickTree<std::uint64_t>>);
+BENCHMARK("tree/range/segment_sum", RangeQueryBench<aisd::RangeSumTree<std::uint64_t>>);
+BENCHMARK("tree/range/segment_min", RangeQueryBench<aisd::RangeMinTree<std::uint64_t>>);
+
+}  // namespace
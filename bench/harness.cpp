@@ -0,0 +1,164 @@
+#include "harness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+
+std::size_t PeakRssKb() {
+    // VmHWM follows clear_refs resets, ru_maxrss does not.
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stoul(line.substr(6));
+        }
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+bool ResetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (!clear_refs) {
+        return false;
+    }
+    clear_refs << "5";
+    clear_refs.flush();
+    return static_cast<bool>(clear_refs);
+}
+
+State::State(std::size_t n) : n_(n), ops_(n) {
+}
+
+void State::ResumeTiming() {
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    timed_ = true;
+    start_allocs_ = CurrentAllocStats();
+    start_ = std::chrono::steady_clock::now();
+}
+
+void State::PauseTiming() {
+    if (!running_) {
+        return;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    AllocStats now = CurrentAllocStats();
+    running_ = false;
+    elapsed_ += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start_);
+    allocs_.count += now.count - start_allocs_.count;
+    allocs_.bytes += now.bytes - start_allocs_.bytes;
+}
+
+std::vector<Benchmark>& Registry() {
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
+Registrar::Registrar(const char* name, BenchFn fn, std::size_t max_n) {
+    Registry().push_back({name, std::move(fn), max_n});
+}
+
+namespace {
+
+struct Result {
+    double ns_per_op = 0;
+    std::uint64_t allocs_per_run = 0;
+    std::uint64_t bytes_per_run = 0;
+    std::size_t peak_rss_kb = 0;
+    int reps = 0;
+};
+
+Result RunCase(const Benchmark& benchmark, std::size_t n, const Options& options) {
+    Result result;
+    ResetPeakRss();
+    double best = 0;
+    double total_sec = 0;
+    while (result.reps < options.max_reps && (result.reps == 0 || total_sec < options.min_time_sec)) {
+        State state(n);
+        AllocStats before = CurrentAllocStats();
+        auto start = std::chrono::steady_clock::now();
+        benchmark.fn(state);
+        auto stop = std::chrono::steady_clock::now();
+        AllocStats after = CurrentAllocStats();
+
+        double elapsed_ns;
+        std::uint64_t allocs;
+        std::uint64_t bytes;
+        if (state.WasTimed()) {
+            state.PauseTiming();
+            elapsed_ns = static_cast<double>(state.Elapsed().count());
+            allocs = state.Allocs().count;
+            bytes = state.Allocs().bytes;
+        } else {
+            elapsed_ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            allocs = after.count - before.count;
+            bytes = after.bytes - before.bytes;
+        }
+        double per_op = elapsed_ns / static_cast<double>(std::max<std::uint64_t>(state.Ops(), 1));
+        if (result.reps == 0 || per_op < best) {
+            best = per_op;
+            result.allocs_per_run = allocs;
+            result.bytes_per_run = bytes;
+        }
+        total_sec += std::chrono::duration<double>(stop - start).count();
+        ++result.reps;
+    }
+    result.ns_per_op = best;
+    result.peak_rss_kb = PeakRssKb();
+    return result;
+}
+
+}  // namespace
+
+int RunAll(const Options& options) {
+    std::vector<Benchmark> benchmarks = Registry();
+    std::sort(benchmarks.begin(), benchmarks.end(),
+              [](const Benchmark& a, const Benchmark& b) { return a.name < b.name; });
+
+    std::printf("%-36s %10s %12s %12s %14s %12s %5s\n", "benchmark", "n", "ns/op", "allocs/run",
+                "bytes/run", "peak_rss_kb", "reps");
+    int ran = 0;
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        for (std::size_t n : options.sizes) {
+            if (n > benchmark.max_n) {
+                continue;
+            }
+            Result result = RunCase(benchmark, n, options);
+            std::printf("%-36s %10zu %12.3f %12llu %14llu %12zu %5d\n", benchmark.name.c_str(), n,
+                        result.ns_per_op, static_cast<unsigned long long>(result.allocs_per_run),
+                        static_cast<unsigned long long>(result.bytes_per_run), result.peak_rss_kb,
+                        result.reps);
+            std::fflush(stdout);
+            ++ran;
+        }
+    }
+    if (ran == 0) {
+        std::fprintf(stderr, "no benchmarks matched filter '%s'\n", options.filter.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace bench
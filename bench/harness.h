@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Global allocation counters, maintained by the replaced operator new/delete
+// in alloc_counter.cpp.
+struct AllocStats {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+AllocStats CurrentAllocStats();
+
+// Peak resident set size of the process in kilobytes. ResetPeakRss() asks the
+// kernel to restart the high-water mark so that every case is measured on its
+// own; it returns false where that is not supported (the peak is then
+// process-wide and monotone).
+std::size_t PeakRssKb();
+bool ResetPeakRss();
+
+// Per-run state handed to a benchmark body. Everything outside the
+// ResumeTiming()/PauseTiming() window (setup, input generation, checks) is
+// excluded from time and allocation figures. A body that never calls them is
+// timed as a whole.
+class State {
+public:
+    explicit State(std::size_t n);
+
+    std::size_t N() const {
+        return n_;
+    }
+
+    void ResumeTiming();
+    void PauseTiming();
+
+    // Number of logical operations performed by the body; ns/op is
+    // elapsed / ops. Defaults to N().
+    void SetOps(std::uint64_t ops) {
+        ops_ = ops;
+    }
+
+    std::uint64_t Ops() const {
+        return ops_;
+    }
+    std::chrono::nanoseconds Elapsed() const {
+        return elapsed_;
+    }
+    const AllocStats& Allocs() const {
+        return allocs_;
+    }
+    bool WasTimed() const {
+        return timed_;
+    }
+
+private:
+    std::size_t n_;
+    std::uint64_t ops_;
+    bool running_ = false;
+    bool timed_ = false;
+    std::chrono::steady_clock::time_point start_;
+    AllocStats start_allocs_;
+    std::chrono::nanoseconds elapsed_{0};
+    AllocStats allocs_;
+};
+
+using BenchFn = std::function<void(State&)>;
+
+struct Benchmark {
+    std::string name;
+    BenchFn fn;
+    std::size_t max_n;  // sizes above this are skipped for the benchmark
+};
+
+std::vector<Benchmark>& Registry();
+
+struct Registrar {
+    Registrar(const char* name, BenchFn fn, std::size_t max_n = 10'000'000);
+};
+
+// Keeps the compiler from discarding a computed value.
+template <class T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct Options {
+    std::vector<std::size_t> sizes;
+    std::string filter;
+    double min_time_sec = 0.2;
+    int max_reps = 50;
+};
+
+// Runs every registered benchmark whose name contains options.filter over
+// options.sizes and prints one table row per (benchmark, n).
+int RunAll(const Options& options);
+
+}  // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+// Registers a benchmark body `void(bench::State&)`:
+//   BENCHMARK("sort/std", [](bench::State& state) { ... });
+#define BENCHMARK(...) \
+    static ::bench::Registrar BENCH_CONCAT(bench_registrar_, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,43 @@
+#include "harness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+void PrintUsage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--filter SUBSTR] [--max-n N] [--min-time SEC] [--max-reps K]\n"
+                 "Runs every registered benchmark over n = 1e3, 1e4, ..., 1e7 (capped by\n"
+                 "--max-n) and prints ns/op, heap allocations per run and peak RSS.\n",
+                 argv0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    std::size_t max_n = 10'000'000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--max-n" && has_value) {
+            max_n = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--min-time" && has_value) {
+            options.min_time_sec = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--max-reps" && has_value) {
+            options.max_reps = std::atoi(argv[++i]);
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+    for (std::size_t n = 1000; n <= max_n && n <= 10'000'000; n *= 10) {
+        options.sizes.push_back(n);
+    }
+    return bench::RunAll(options);
+}
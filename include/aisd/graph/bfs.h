@@ -0,0 +1,217 @@
+#pragma once
+
+#include <aisd/graph/csr_graph.h>
+#include <aisd/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+inline constexpr std::uint32_t kUnreachedDepth = std::numeric_limits<std::uint32_t>::max();
+
+namespace graph_detail {
+
+// Frontiers smaller than this are expanded on the calling thread: spawning
+// workers costs more than the step itself.
+inline constexpr std::size_t kParallelFrontier = 1 << 12;
+
+class Bitmap {
+public:
+    explicit Bitmap(std::size_t size) : words_((size + 63) / 64, 0) {
+    }
+
+    bool Get(std::size_t i) const {
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    void Set(std::size_t i) {
+        words_[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+
+    std::uint64_t Word(std::size_t w) const {
+        return words_[w];
+    }
+
+    std::uint64_t& Word(std::size_t w) {
+        return words_[w];
+    }
+
+    std::size_t WordCount() const {
+        return words_.size();
+    }
+
+    void Clear() {
+        std::fill(words_.begin(), words_.end(), 0);
+    }
+
+    void Swap(Bitmap& other) {
+        words_.swap(other.words_);
+    }
+
+private:
+    std::vector<std::uint64_t> words_;
+};
+
+// Top-down step: every frontier vertex claims its unvisited out-neighbours.
+// Returns the out-degree sum of the new frontier.
+template <class Weight>
+EdgeIndex TopDownStep(const CsrGraph<Weight>& graph, std::vector<std::atomic<std::uint32_t>>& depth,
+                      std::vector<VertexId>& frontier, std::uint32_t level, unsigned threads) {
+    unsigned tasks = frontier.size() < kParallelFrontier ? 1 : threads;
+    std::vector<std::vector<VertexId>> next(tasks);
+    std::vector<EdgeIndex> scout(tasks, 0);
+    ParallelFor(tasks, tasks, [&](std::size_t task) {
+        std::size_t begin = frontier.size() * task / tasks;
+        std::size_t end = frontier.size() * (task + 1) / tasks;
+        for (std::size_t i = begin; i < end; ++i) {
+            for (VertexId v : graph.Neighbors(frontier[i])) {
+                std::uint32_t current = depth[v].load(std::memory_order_relaxed);
+                if (current == kUnreachedDepth &&
+                    depth[v].compare_exchange_strong(current, level + 1, std::memory_order_relaxed)) {
+                    next[task].push_back(v);
+                    scout[task] += graph.Degree(v);
+                }
+            }
+        }
+    });
+    frontier.clear();
+    EdgeIndex total = 0;
+    for (unsigned task = 0; task < tasks; ++task) {
+        frontier.insert(frontier.end(), next[task].begin(), next[task].end());
+        total += scout[task];
+    }
+    return total;
+}
+
+struct BottomUpResult {
+    std::size_t awake;  // vertices in the new frontier
+    EdgeIndex scout;    // their out-degree sum
+};
+
+// Bottom-up step: every unvisited vertex looks for any in-neighbour in the
+// frontier and stops at the first one. Threads own whole bitmap words, so
+// the next frontier is written without atomics.
+template <class Weight>
+BottomUpResult BottomUpStep(const CsrGraph<Weight>& graph, const CsrGraph<Weight>& transpose,
+                            std::vector<std::atomic<std::uint32_t>>& depth, const Bitmap& frontier, Bitmap& next,
+                            std::uint32_t level, unsigned threads) {
+    std::size_t vertex_count = transpose.VertexCount();
+    std::size_t words = next.WordCount();
+    unsigned tasks = vertex_count < kParallelFrontier ? 1 : threads;
+    std::vector<std::size_t> awake(tasks, 0);
+    std::vector<EdgeIndex> scout(tasks, 0);
+    ParallelFor(tasks, tasks, [&](std::size_t task) {
+        for (std::size_t w = words * task / tasks; w < words * (task + 1) / tasks; ++w) {
+            std::uint64_t bits = 0;
+            std::size_t last = std::min(vertex_count, (w + 1) * 64);
+            for (std::size_t v = w * 64; v < last; ++v) {
+                if (depth[v].load(std::memory_order_relaxed) != kUnreachedDepth) {
+                    continue;
+                }
+                for (VertexId u : transpose.Neighbors(static_cast<VertexId>(v))) {
+                    if (frontier.Get(u)) {
+                        depth[v].store(level + 1, std::memory_order_relaxed);
+                        bits |= std::uint64_t{1} << (v % 64);
+                        ++awake[task];
+                        scout[task] += graph.Degree(static_cast<VertexId>(v));
+                        break;
+                    }
+                }
+            }
+            next.Word(w) = bits;
+        }
+    });
+    BottomUpResult total{0, 0};
+    for (unsigned task = 0; task < tasks; ++task) {
+        total.awake += awake[task];
+        total.scout += scout[task];
+    }
+    return total;
+}
+
+}  // namespace graph_detail
+
+// Direction-optimizing breadth-first search (Beamer, Asanovic and Patterson,
+// 2012). Returns the hop distance of every vertex from source, or
+// kUnreachedDepth.
+//
+// Small frontiers are expanded top-down from a vertex queue. Once the edges
+// leaving the frontier exceed 1/kAlpha of the edges still unexplored (the
+// out-edges of vertices no step has expanded yet), the search switches to
+// bottom-up steps over a frontier bitmap, where each unvisited vertex stops
+// at its first parent found; on low-diameter graphs this skips most edge
+// checks of the few huge middle levels. It switches back once the frontier
+// shrinks below n/kBeta. Both steps run on `threads` threads (0 = all cores);
+// the bottom-up one scans in-neighbours, so a directed graph needs its
+// transpose.
+template <class Weight>
+std::vector<std::uint32_t> Bfs(const CsrGraph<Weight>& graph, const CsrGraph<Weight>& transpose, VertexId source,
+                               unsigned threads = 0) {
+    constexpr EdgeIndex kAlpha = 15;
+    constexpr std::size_t kBeta = 18;
+    std::size_t n = graph.VertexCount();
+    threads = ResolveThreads(threads);
+    std::vector<std::atomic<std::uint32_t>> depth(n);
+    for (auto& d : depth) {
+        d.store(kUnreachedDepth, std::memory_order_relaxed);
+    }
+    depth[source].store(0, std::memory_order_relaxed);
+
+    std::vector<VertexId> frontier{source};
+    graph_detail::Bitmap current(n);
+    graph_detail::Bitmap next(n);
+    EdgeIndex unexplored = graph.ArcCount();
+    EdgeIndex scout = graph.Degree(source);
+    std::uint32_t level = 0;
+    while (!frontier.empty()) {
+        if (scout > unexplored / kAlpha) {
+            current.Clear();
+            for (VertexId v : frontier) {
+                current.Set(v);
+            }
+            std::size_t awake = frontier.size();
+            std::size_t previous;
+            do {
+                unexplored -= std::min(scout, unexplored);
+                previous = awake;
+                graph_detail::BottomUpResult step =
+                    graph_detail::BottomUpStep(graph, transpose, depth, current, next, level, threads);
+                awake = step.awake;
+                scout = step.scout;
+                current.Swap(next);
+                ++level;
+            } while (awake >= previous || awake > n / kBeta);
+            frontier.clear();
+            for (std::size_t w = 0; w < current.WordCount(); ++w) {
+                for (std::uint64_t bits = current.Word(w); bits != 0; bits &= bits - 1) {
+                    auto bit = static_cast<std::size_t>(__builtin_ctzll(bits));
+                    frontier.push_back(static_cast<VertexId>(w * 64 + bit));
+                }
+            }
+        } else {
+            unexplored -= std::min(scout, unexplored);
+            scout = graph_detail::TopDownStep(graph, depth, frontier, level, threads);
+            ++level;
+        }
+    }
+
+    std::vector<std::uint32_t> result(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        result[v] = depth[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// BFS over an undirected (symmetrized) graph, which is its own transpose.
+template <class Weight>
+std::vector<std::uint32_t> Bfs(const CsrGraph<Weight>& graph, VertexId source, unsigned threads = 0) {
+    return Bfs(graph, graph, source, threads);
+}
+
+}  // namespace aisd
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <aisd/graph/csr_graph.h>
+#include <aisd/graph/union_find.h>
+#include <aisd/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+namespace graph_detail {
+
+// Vertex ranges below this are scanned on the calling thread.
+inline constexpr std::size_t kParallelVertices = 1 << 14;
+
+// Total order on edges: weight, then the endpoint pair. Both arcs of an
+// undirected edge compare equal, and ties are broken the same way by every
+// component, which is what keeps the Borůvka choices cycle-free.
+template <class Weight>
+bool LighterEdge(Weight a_weight, VertexId a_from, VertexId a_to, Weight b_weight, VertexId b_from, VertexId b_to) {
+    if (a_weight != b_weight) {
+        return a_weight < b_weight;
+    }
+    return std::make_pair(std::min(a_from, a_to), std::max(a_from, a_to)) <
+           std::make_pair(std::min(b_from, b_to), std::max(b_from, b_to));
+}
+
+}  // namespace graph_detail
+
+// Minimum spanning forest of an undirected graph stored symmetrized (every
+// edge as two arcs). Returns the forest edges with from < to.
+//
+// Parallel Borůvka: each round every vertex finds its lightest arc leaving
+// its component, each component keeps the lightest of its vertices' picks
+// (a compare-and-swap on the picking vertex id), the picks are merged in a
+// union-find and component labels are refreshed. Every round at least halves
+// the number of components. Rows are scanned lightest first from a
+// per-vertex cursor: an arc inside a component stays inside, so the cursor
+// never moves back and all rounds together touch every arc once, plus O(n)
+// per round. A graph whose rows are not sorted yet is copied and sorted;
+// call SortNeighbors() beforehand to avoid the copy on huge graphs.
+template <class Weight>
+std::vector<Edge<Weight>> BoruvkaMst(const CsrGraph<Weight>& graph, unsigned threads = 0) {
+    assert(graph.HasWeights());
+    if (!graph.NeighborsSorted()) {
+        CsrGraph<Weight> sorted = graph;
+        sorted.SortNeighbors(threads);
+        return BoruvkaMst(sorted, threads);
+    }
+    std::size_t n = graph.VertexCount();
+    unsigned tasks = n < graph_detail::kParallelVertices ? 1 : ResolveThreads(threads);
+    const EdgeIndex* offsets = graph.Offsets().data();
+    const VertexId* targets = graph.Targets().data();
+    const Weight* weights = graph.Weights().data();
+
+    UnionFind components(n);
+    std::vector<VertexId> label(n);
+    std::iota(label.begin(), label.end(), VertexId{0});
+    std::vector<VertexId> roots(label);
+    // cursor[v]: first arc of v not yet known to be internal, offsets[v + 1]
+    // once v has none left.
+    std::vector<EdgeIndex> cursor(offsets, offsets + n);
+    std::vector<std::atomic<VertexId>> component_pick(n);
+    for (auto& pick : component_pick) {
+        pick.store(kNoVertex, std::memory_order_relaxed);
+    }
+    auto for_vertices = [&](auto&& fn) {
+        ParallelFor(tasks, tasks, [&](std::size_t task) {
+            for (std::size_t v = n * task / tasks; v < n * (task + 1) / tasks; ++v) {
+                fn(static_cast<VertexId>(v));
+            }
+        });
+    };
+
+    std::vector<Edge<Weight>> forest;
+    while (true) {
+        for_vertices([&](VertexId v) {
+            VertexId own = label[v];
+            EdgeIndex best = cursor[v];
+            while (best < offsets[v + 1] && label[targets[best]] == own) {
+                ++best;
+            }
+            cursor[v] = best;
+            if (best == offsets[v + 1]) {
+                return;
+            }
+            auto& pick = component_pick[own];
+            // Acquire/release so that cursor of the current holder is visible.
+            VertexId current = pick.load(std::memory_order_acquire);
+            while (current == kNoVertex || graph_detail::LighterEdge(weights[best], v, targets[best],
+                                                                     weights[cursor[current]], current,
+                                                                     targets[cursor[current]])) {
+                if (pick.compare_exchange_weak(current, v, std::memory_order_release, std::memory_order_acquire)) {
+                    break;
+                }
+            }
+        });
+
+        std::size_t merged = 0;
+        for (VertexId root : roots) {
+            VertexId v = component_pick[root].load(std::memory_order_relaxed);
+            if (v == kNoVertex) {
+                continue;
+            }
+            component_pick[root].store(kNoVertex, std::memory_order_relaxed);
+            EdgeIndex arc = cursor[v];
+            VertexId to = targets[arc];
+            if (components.Union(v, to)) {
+                forest.push_back({std::min(v, to), std::max(v, to), weights[arc]});
+                ++merged;
+            }
+        }
+        if (merged == 0) {
+            break;
+        }
+        for_vertices([&](VertexId v) { label[v] = components.Root(v); });
+        std::size_t kept = 0;
+        for (VertexId root : roots) {
+            if (components.Root(root) == root) {
+                roots[kept++] = root;
+            }
+        }
+        roots.resize(kept);
+    }
+    return forest;
+}
+
+}  // namespace aisd
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <aisd/parallel.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+using VertexId = std::uint32_t;
+using EdgeIndex = std::uint64_t;
+
+inline constexpr VertexId kNoVertex = std::numeric_limits<VertexId>::max();
+
+template <class Weight = std::uint32_t>
+struct Edge {
+    VertexId from;
+    VertexId to;
+    Weight weight;
+};
+
+// Read-only view of a contiguous run of a CSR array, usable in range-for.
+template <class T>
+class ArrayRange {
+public:
+    ArrayRange(const T* first, const T* last) : first_(first), last_(last) {
+    }
+
+    const T* begin() const {
+        return first_;
+    }
+
+    const T* end() const {
+        return last_;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(last_ - first_);
+    }
+
+    const T& operator[](std::size_t i) const {
+        return first_[i];
+    }
+
+private:
+    const T* first_;
+    const T* last_;
+};
+
+// Directed graph in compressed sparse row form: the targets of all arcs
+// leaving vertex v are targets[offsets[v] .. offsets[v + 1]), weights (if
+// kept) are parallel to targets. That is 4 bytes per arc (8 with weights)
+// plus 8 per vertex, against 24+ bytes of vector header per vertex and
+// allocator slack per list for vector<vector<>>, and neighbour scans are
+// sequential reads.
+//
+// Undirected graphs are stored symmetrized, every edge as two arcs.
+template <class Weight = std::uint32_t>
+class CsrGraph {
+public:
+    using WeightType = Weight;
+
+    CsrGraph() : offsets_(1, 0) {
+    }
+
+    // Builds the graph in two passes over an edge source without
+    // materializing the edge list: for_each_edge(fn) must call
+    // fn(from, to, weight) for every edge and produce the same sequence both
+    // times it is invoked. The vertex count grows past vertex_count if an
+    // edge names a larger id. With symmetrize every edge also gets its
+    // reverse arc (self-loops are stored once); without weighted the weights
+    // are dropped.
+    template <class ForEachEdge>
+    static CsrGraph Build(VertexId vertex_count, ForEachEdge&& for_each_edge, bool symmetrize, bool weighted);
+
+    static CsrGraph FromEdges(VertexId vertex_count, const std::vector<Edge<Weight>>& edges, bool symmetrize = false,
+                              bool weighted = true) {
+        return Build(
+            vertex_count,
+            [&edges](auto&& fn) {
+                for (const auto& edge : edges) {
+                    fn(edge.from, edge.to, edge.weight);
+                }
+            },
+            symmetrize, weighted);
+    }
+
+    // Graph with every arc reversed, i.e. in-neighbours as neighbours.
+    CsrGraph Transpose() const;
+
+    // Sorts every adjacency row by (weight, target), or by target without
+    // weights, in place on `threads` threads (0 = all cores). Lightest-first
+    // rows let BoruvkaMst skip each arc at most once.
+    void SortNeighbors(unsigned threads = 0);
+
+    bool NeighborsSorted() const {
+        return neighbors_sorted_;
+    }
+
+    VertexId VertexCount() const {
+        return static_cast<VertexId>(offsets_.size() - 1);
+    }
+
+    // Number of stored arcs (twice the edge count of a symmetrized graph).
+    EdgeIndex ArcCount() const {
+        return offsets_.back();
+    }
+
+    bool HasWeights() const {
+        return !weights_.empty() || ArcCount() == 0;
+    }
+
+    EdgeIndex Degree(VertexId v) const {
+        return offsets_[v + 1] - offsets_[v];
+    }
+
+    ArrayRange<VertexId> Neighbors(VertexId v) const {
+        return {targets_.data() + offsets_[v], targets_.data() + offsets_[v + 1]};
+    }
+
+    ArrayRange<Weight> NeighborWeights(VertexId v) const {
+        assert(HasWeights());
+        return {weights_.data() + offsets_[v], weights_.data() + offsets_[v + 1]};
+    }
+
+    const std::vector<EdgeIndex>& Offsets() const {
+        return offsets_;
+    }
+
+    const std::vector<VertexId>& Targets() const {
+        return targets_;
+    }
+
+    const std::vector<Weight>& Weights() const {
+        return weights_;
+    }
+
+    std::size_t MemoryBytes() const {
+        return offsets_.capacity() * sizeof(EdgeIndex) + targets_.capacity() * sizeof(VertexId) +
+               weights_.capacity() * sizeof(Weight);
+    }
+
+private:
+    void GrowTo(std::size_t vertex_count) {
+        if (vertex_count + 1 > offsets_.size()) {
+            offsets_.resize(vertex_count + 1, 0);
+        }
+    }
+
+    // Counting-sort placement: offsets_[v] is the next free arc slot of v
+    // while filling and ends up as the start of v + 1, so shifting the array
+    // by one restores the row starts without a second cursor array.
+    void PrefixSums() {
+        EdgeIndex sum = 0;
+        for (auto& offset : offsets_) {
+            EdgeIndex count = offset;
+            offset = sum;
+            sum += count;
+        }
+    }
+
+    void ShiftOffsets() {
+        for (std::size_t v = offsets_.size() - 1; v > 0; --v) {
+            offsets_[v] = offsets_[v - 1];
+        }
+        offsets_[0] = 0;
+    }
+
+    std::vector<EdgeIndex> offsets_;
+    std::vector<VertexId> targets_;
+    std::vector<Weight> weights_;
+    bool neighbors_sorted_ = false;
+};
+
+template <class Weight>
+template <class ForEachEdge>
+CsrGraph<Weight> CsrGraph<Weight>::Build(VertexId vertex_count, ForEachEdge&& for_each_edge, bool symmetrize,
+                                         bool weighted) {
+    CsrGraph graph;
+    graph.GrowTo(vertex_count);
+    // Pass 1: out-degrees, counted in offsets_[v].
+    for_each_edge([&](VertexId from, VertexId to, const Weight&) {
+        graph.GrowTo(static_cast<std::size_t>(from > to ? from : to) + 1);
+        ++graph.offsets_[from];
+        if (symmetrize && from != to) {
+            ++graph.offsets_[to];
+        }
+    });
+    graph.PrefixSums();
+    EdgeIndex arcs = graph.offsets_.back();
+    graph.targets_.resize(arcs);
+    if (weighted) {
+        graph.weights_.resize(arcs);
+    }
+
+    // Pass 2: place the arcs.
+    auto place = [&](VertexId from, VertexId to, const Weight& weight) {
+        EdgeIndex slot = graph.offsets_[from]++;
+        graph.targets_[slot] = to;
+        if (weighted) {
+            graph.weights_[slot] = weight;
+        }
+    };
+    for_each_edge([&](VertexId from, VertexId to, const Weight& weight) {
+        place(from, to, weight);
+        if (symmetrize && from != to) {
+            place(to, from, weight);
+        }
+    });
+    graph.ShiftOffsets();
+    return graph;
+}
+
+template <class Weight>
+CsrGraph<Weight> CsrGraph<Weight>::Transpose() const {
+    CsrGraph transpose;
+    transpose.offsets_.assign(offsets_.size(), 0);
+    for (VertexId target : targets_) {
+        ++transpose.offsets_[target];
+    }
+    transpose.PrefixSums();
+    transpose.targets_.resize(targets_.size());
+    transpose.weights_.resize(weights_.size());
+    for (VertexId v = 0; v < VertexCount(); ++v) {
+        for (EdgeIndex arc = offsets_[v]; arc < offsets_[v + 1]; ++arc) {
+            EdgeIndex slot = transpose.offsets_[targets_[arc]]++;
+            transpose.targets_[slot] = v;
+            if (!weights_.empty()) {
+                transpose.weights_[slot] = weights_[arc];
+            }
+        }
+    }
+    transpose.ShiftOffsets();
+    return transpose;
+}
+
+template <class Weight>
+void CsrGraph<Weight>::SortNeighbors(unsigned threads) {
+    std::size_t n = VertexCount();
+    unsigned tasks = static_cast<unsigned>(std::min<std::size_t>(ResolveThreads(threads), n / 1024 + 1));
+    ParallelFor(tasks, tasks, [&](std::size_t task) {
+        std::vector<std::pair<Weight, VertexId>> row;
+        for (std::size_t v = n * task / tasks; v < n * (task + 1) / tasks; ++v) {
+            EdgeIndex begin = offsets_[v];
+            EdgeIndex end = offsets_[v + 1];
+            if (weights_.empty()) {
+                std::sort(targets_.begin() + begin, targets_.begin() + end);
+                continue;
+            }
+            row.clear();
+            for (EdgeIndex arc = begin; arc < end; ++arc) {
+                row.emplace_back(weights_[arc], targets_[arc]);
+            }
+            std::sort(row.begin(), row.end());
+            for (EdgeIndex arc = begin; arc < end; ++arc) {
+                weights_[arc] = row[arc - begin].first;
+                targets_[arc] = row[arc - begin].second;
+            }
+        }
+    });
+    neighbors_sorted_ = true;
+}
+
+}  // namespace aisd
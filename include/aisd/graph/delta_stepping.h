@@ -0,0 +1,190 @@
+#pragma once
+
+#include <aisd/graph/bfs.h>
+#include <aisd/graph/csr_graph.h>
+#include <aisd/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+inline constexpr std::uint64_t kUnreachedDistance = std::numeric_limits<std::uint64_t>::max();
+
+// Bucket width used when the caller passes delta = 0: max weight divided by
+// the average degree (Meyer and Sanders), so that a bucket holds about one
+// light hop of work per vertex.
+template <class Weight>
+std::uint64_t DefaultDelta(const CsrGraph<Weight>& graph) {
+    if (graph.VertexCount() == 0 || graph.ArcCount() == 0) {
+        return 1;
+    }
+    std::uint64_t max_weight = *std::max_element(graph.Weights().begin(), graph.Weights().end());
+    std::uint64_t average_degree = std::max<std::uint64_t>(1, graph.ArcCount() / graph.VertexCount());
+    return std::max<std::uint64_t>(1, max_weight / average_degree);
+}
+
+namespace graph_detail {
+
+// Upper bound on the bucket ring of each thread: with heavy weights relative
+// to delta, farther buckets wait in the far heap instead.
+inline constexpr std::size_t kMaxRingBuckets = 1 << 12;
+
+}  // namespace graph_detail
+
+// Single-source shortest paths by delta-stepping (Meyer and Sanders, 2003)
+// for non-negative integer weights. Returns the distance of every vertex, or
+// kUnreachedDistance.
+//
+// Tentative distances are grouped into buckets of width delta; all vertices
+// of the lowest non-empty bucket are relaxed in parallel, with distances
+// lowered by compare-and-swap. Improved vertices go to per-thread bins, so
+// the only shared writes are the distance CASes; a bucket refilled by its own
+// light edges is simply processed again. delta = 1 degenerates to Dial's
+// Dijkstra, huge delta to parallel Bellman-Ford.
+//
+// A relaxation from bucket b lands at most ceil(max_weight / delta) buckets
+// ahead, so each thread keeps a cyclic ring of that many + 1 bins, capped at
+// kMaxRingBuckets. Targets beyond the ring go to a min-heap of (bucket,
+// vertex) and move into the ring once it reaches them. Bins are freed once
+// processed, so memory is O(n + m) however large distance / delta gets.
+template <class Weight>
+std::vector<std::uint64_t> DeltaStepping(const CsrGraph<Weight>& graph, VertexId source, std::uint64_t delta = 0,
+                                         unsigned threads = 0) {
+    static_assert(std::is_integral_v<Weight> && std::is_unsigned_v<Weight>,
+                  "delta-stepping needs non-negative integer weights");
+    assert(graph.HasWeights());
+    std::size_t n = graph.VertexCount();
+    if (delta == 0) {
+        delta = DefaultDelta(graph);
+    }
+    threads = ResolveThreads(threads);
+    std::vector<std::atomic<std::uint64_t>> distance(n);
+    for (auto& d : distance) {
+        d.store(kUnreachedDistance, std::memory_order_relaxed);
+    }
+    distance[source].store(0, std::memory_order_relaxed);
+
+    const EdgeIndex* offsets = graph.Offsets().data();
+    const VertexId* targets = graph.Targets().data();
+    const Weight* weights = graph.Weights().data();
+    std::uint64_t max_weight =
+        graph.ArcCount() == 0 ? 0 : *std::max_element(graph.Weights().begin(), graph.Weights().end());
+    std::uint64_t span = max_weight / delta + (max_weight % delta != 0) + 1;
+    std::size_t ring = static_cast<std::size_t>(std::min<std::uint64_t>(span, graph_detail::kMaxRingBuckets));
+
+    // bins[thread][bucket % ring]: vertices improved into that bucket by the
+    // thread. Every bin holds buckets in [bucket, bucket + ring).
+    std::vector<std::vector<std::vector<VertexId>>> bins(threads, std::vector<std::vector<VertexId>>(ring));
+    std::vector<std::size_t> binned(threads, 0);
+    // Improvements too far ahead for the ring, gathered per thread and then
+    // merged into one heap. An entry is stale once its vertex has improved
+    // to a lower bucket; that improvement was queued on its own.
+    using FarEntry = std::pair<std::uint64_t, VertexId>;
+    std::vector<std::vector<FarEntry>> far(threads);
+    std::priority_queue<FarEntry, std::vector<FarEntry>, std::greater<>> far_heap;
+    auto live = [&](const FarEntry& entry) {
+        return distance[entry.second].load(std::memory_order_relaxed) / delta == entry.first;
+    };
+
+    std::vector<VertexId> frontier{source};
+    std::uint64_t bucket = 0;
+    while (true) {
+        unsigned tasks = frontier.size() < graph_detail::kParallelFrontier ? 1 : threads;
+        ParallelFor(tasks, tasks, [&](std::size_t task) {
+            auto& own = bins[task];
+            std::size_t begin = frontier.size() * task / tasks;
+            std::size_t end = frontier.size() * (task + 1) / tasks;
+            for (std::size_t i = begin; i < end; ++i) {
+                VertexId u = frontier[i];
+                std::uint64_t du = distance[u].load(std::memory_order_relaxed);
+                if (du / delta < bucket) {
+                    continue;  // settled in an earlier bucket, this entry is stale
+                }
+                for (EdgeIndex arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+                    VertexId v = targets[arc];
+                    std::uint64_t candidate = du + weights[arc];
+                    std::uint64_t current = distance[v].load(std::memory_order_relaxed);
+                    while (candidate < current) {
+                        if (distance[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                            std::uint64_t target = candidate / delta;
+                            if (target - bucket < ring) {
+                                own[static_cast<std::size_t>(target % ring)].push_back(v);
+                                ++binned[task];
+                            } else {
+                                far[task].push_back({target, v});
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+        for (auto& pile : far) {
+            for (const FarEntry& entry : pile) {
+                far_heap.push(entry);
+            }
+            pile.clear();
+        }
+
+        // Lowest non-empty bucket: the first live far entry or the first
+        // non-empty bin before it; improvements never go below the current
+        // bucket.
+        while (!far_heap.empty() && !live(far_heap.top())) {
+            far_heap.pop();
+        }
+        std::uint64_t next = far_heap.empty() ? kUnreachedDistance : far_heap.top().first;
+        for (std::size_t task = 0; task < bins.size(); ++task) {
+            for (std::uint64_t b = bucket; binned[task] != 0 && b < bucket + ring && b < next; ++b) {
+                if (!bins[task][static_cast<std::size_t>(b % ring)].empty()) {
+                    next = b;
+                    break;
+                }
+            }
+        }
+        if (next == kUnreachedDistance) {
+            break;
+        }
+        // The ring window moves to [next, next + ring): pull in far entries
+        // it now covers.
+        while (!far_heap.empty() && far_heap.top().first - next < ring) {
+            FarEntry entry = far_heap.top();
+            far_heap.pop();
+            if (live(entry)) {
+                bins[0][static_cast<std::size_t>(entry.first % ring)].push_back(entry.second);
+                ++binned[0];
+            }
+        }
+
+        bucket = next;
+        std::vector<VertexId> gathered;
+        for (std::size_t task = 0; task < bins.size(); ++task) {
+            auto& bin = bins[task][static_cast<std::size_t>(bucket % ring)];
+            binned[task] -= bin.size();
+            if (gathered.empty()) {
+                gathered.swap(bin);
+            } else {
+                gathered.insert(gathered.end(), bin.begin(), bin.end());
+                std::vector<VertexId>().swap(bin);
+            }
+        }
+        frontier = std::move(gathered);
+    }
+
+    std::vector<std::uint64_t> result(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        result[v] = distance[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+}  // namespace aisd
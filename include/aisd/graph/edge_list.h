@@ -0,0 +1,71 @@
+#pragma once
+
+#include <aisd/graph/csr_graph.h>
+#include <aisd/string/mapped_file.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace aisd {
+
+// Binary edge list: a headerless sequence of records
+//     uint32 from, uint32 to[, Weight weight]
+// in host byte order, the weight present only for weighted files. The vertex
+// count is one past the largest id.
+template <class Weight = std::uint32_t>
+constexpr std::size_t EdgeRecordSize(bool weighted) {
+    return 2 * sizeof(VertexId) + (weighted ? sizeof(Weight) : 0);
+}
+
+// Loads a binary edge list straight into CSR form. The file is memory-mapped
+// and streamed twice (degrees, then placement) with already read pages
+// dropped, so peak memory is the CSR arrays themselves: no intermediate edge
+// vector, and the file never has to be resident as a whole.
+template <class Weight = std::uint32_t>
+CsrGraph<Weight> LoadEdgeList(const std::string& path, bool weighted, bool symmetrize = false) {
+    constexpr std::size_t kRecordsPerChunk = std::size_t{1} << 20;
+    std::size_t record_size = EdgeRecordSize<Weight>(weighted);
+    MappedFile file = MappedFile::OpenReadOnly(path);
+    if (file.Size() % record_size != 0) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                path + ": size is not a multiple of the edge record size");
+    }
+    auto for_each_edge = [&](auto&& fn) {
+        file.ForEachChunk(record_size * kRecordsPerChunk, [&](std::string_view chunk, std::size_t) {
+            for (std::size_t at = 0; at < chunk.size(); at += record_size) {
+                VertexId from;
+                VertexId to;
+                Weight weight{};
+                std::memcpy(&from, chunk.data() + at, sizeof(VertexId));
+                std::memcpy(&to, chunk.data() + at + sizeof(VertexId), sizeof(VertexId));
+                if (weighted) {
+                    std::memcpy(&weight, chunk.data() + at + 2 * sizeof(VertexId), sizeof(Weight));
+                }
+                fn(from, to, weight);
+            }
+        });
+    };
+    return CsrGraph<Weight>::Build(0, for_each_edge, symmetrize, weighted);
+}
+
+template <class Weight>
+void SaveEdgeList(const std::string& path, const std::vector<Edge<Weight>>& edges, bool weighted) {
+    std::size_t record_size = EdgeRecordSize<Weight>(weighted);
+    MappedFile file = MappedFile::CreateReadWrite(path, edges.size() * record_size);
+    char* out = file.MutableData();
+    for (const auto& edge : edges) {
+        std::memcpy(out, &edge.from, sizeof(VertexId));
+        std::memcpy(out + sizeof(VertexId), &edge.to, sizeof(VertexId));
+        if (weighted) {
+            std::memcpy(out + 2 * sizeof(VertexId), &edge.weight, sizeof(Weight));
+        }
+        out += record_size;
+    }
+}
+
+}  // namespace aisd
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <aisd/graph/csr_graph.h>
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// Disjoint set union with union by size and path halving: near-constant
+// amortized Find/Union in two flat arrays.
+class UnionFind {
+public:
+    explicit UnionFind(std::size_t size) : parent_(size), size_(size, 1), set_count_(size) {
+        std::iota(parent_.begin(), parent_.end(), VertexId{0});
+    }
+
+    std::size_t Size() const {
+        return parent_.size();
+    }
+
+    std::size_t SetCount() const {
+        return set_count_;
+    }
+
+    VertexId Find(VertexId v) {
+        while (parent_[v] != v) {
+            parent_[v] = parent_[parent_[v]];
+            v = parent_[v];
+        }
+        return v;
+    }
+
+    // Find without path compression, safe to call from several threads while
+    // nobody unions. Union by size keeps it O(log n).
+    VertexId Root(VertexId v) const {
+        while (parent_[v] != v) {
+            v = parent_[v];
+        }
+        return v;
+    }
+
+    // Returns false if a and b were already in one set.
+    bool Union(VertexId a, VertexId b) {
+        a = Find(a);
+        b = Find(b);
+        if (a == b) {
+            return false;
+        }
+        if (size_[a] < size_[b]) {
+            std::swap(a, b);
+        }
+        parent_[b] = a;
+        size_[a] += size_[b];
+        --set_count_;
+        return true;
+    }
+
+    bool Connected(VertexId a, VertexId b) {
+        return Find(a) == Find(b);
+    }
+
+private:
+    std::vector<VertexId> parent_;
+    std::vector<VertexId> size_;
+    std::size_t set_count_;
+};
+
+}  // namespace aisd
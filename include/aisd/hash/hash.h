@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace aisd {
+
+// Final mixer applied on top of the user's hash function. Open addressing
+// takes the bucket from the high bits and the control tag from the low ones,
+// so the weak std::hash of integers (identity in libstdc++) must be spread
+// over all bits first. 128-bit multiply-fold with the golden-ratio constant.
+inline std::uint64_t MixHash(std::uint64_t value) {
+    unsigned __int128 product = static_cast<unsigned __int128>(value) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+}
+
+template <class Hash, class Key>
+std::uint64_t HashKey(const Hash& hash, const Key& key) {
+    return MixHash(static_cast<std::uint64_t>(hash(key)));
+}
+
+}  // namespace aisd
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <aisd/hash/hash.h>
+#include <aisd/hash/swiss_table.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// Linear-probing hash map with Robin Hood insertion and backward-shift
+// deletion.
+//
+// Every slot stores its probe distance in a byte array next to the slot
+// array. Insertion moves the richer element on (the one closer to its home
+// slot), which keeps probe lengths short and almost uniform even at 95%+ load;
+// lookups stop as soon as they meet an element closer to home than the probe,
+// and keys are only compared where the distances are equal. Erase shifts the
+// following cluster back by one instead of leaving a tombstone, so the table
+// never degrades under insert/erase churn.
+//
+// A probe distance must fit in its byte. If an insertion would need more and
+// the table is at least half full, the table doubles. At lower load the long
+// cluster means keys share their full hash, and doubling cannot separate
+// them, so Insert throws std::length_error and leaves the map unchanged. That
+// happens from about 255 keys with one hash; FlatHashMap copes with those.
+template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<>>
+class RobinHoodMap {
+public:
+    using Slot = hash_detail::MapSlot<Key, Value>;
+
+    static constexpr double kDefaultMaxLoadFactor = 0.9;
+    static constexpr double kCompactMaxLoadFactor = 0.97;
+
+    explicit RobinHoodMap(double max_load_factor = kDefaultMaxLoadFactor, Hash hash = Hash(),
+                          Equal equal = Equal())
+        : hash_(std::move(hash)), equal_(std::move(equal)), max_load_factor_(max_load_factor) {
+        assert(max_load_factor > 0 && max_load_factor < 1);
+    }
+
+    RobinHoodMap(const RobinHoodMap&) = delete;
+    RobinHoodMap& operator=(const RobinHoodMap&) = delete;
+
+    RobinHoodMap(RobinHoodMap&& other) noexcept {
+        Swap(other);
+    }
+
+    RobinHoodMap& operator=(RobinHoodMap&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    ~RobinHoodMap() {
+        Destroy();
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    std::size_t Capacity() const {
+        return capacity_;
+    }
+
+    double MaxLoadFactor() const {
+        return max_load_factor_;
+    }
+
+    void Clear() {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (dist_[i] != 0) {
+                slots_[i].~Slot();
+                dist_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    void Reserve(std::size_t size) {
+        std::size_t capacity = capacity_ == 0 ? kMinCapacity : capacity_;
+        while (MaxSize(capacity) < size) {
+            capacity *= 2;
+        }
+        if (capacity != capacity_) {
+            Rehash(capacity);
+        }
+    }
+
+    // Returns false (and leaves the old value) if the key was present.
+    // Insert, InsertOrAssign and operator[] throw std::length_error if the
+    // key cannot be placed (see above); the map and the arguments are then
+    // left untouched.
+    template <class K, class V>
+    bool Insert(K&& key, V&& value) {
+        return TryEmplace(std::forward<K>(key), std::forward<V>(value)).second;
+    }
+
+    template <class K>
+    void InsertOrAssign(K&& key, Value value) {
+        auto [slot, inserted] = TryEmplace(std::forward<K>(key), value);
+        if (!inserted) {
+            slot->value = std::move(value);
+        }
+    }
+
+    template <class K>
+    Value& operator[](K&& key) {
+        return TryEmplace(std::forward<K>(key), Value()).first->value;
+    }
+
+    template <class K>
+    Value* FindValue(const K& key) {
+        std::size_t index = FindIndex(key);
+        return index == kNotFound ? nullptr : &slots_[index].value;
+    }
+
+    template <class K>
+    const Value* FindValue(const K& key) const {
+        return const_cast<RobinHoodMap*>(this)->FindValue(key);
+    }
+
+    template <class K>
+    bool Contains(const K& key) const {
+        return FindIndex(key) != kNotFound;
+    }
+
+    template <class K>
+    bool Erase(const K& key) {
+        std::size_t index = FindIndex(key);
+        if (index == kNotFound) {
+            return false;
+        }
+        slots_[index].~Slot();
+        std::size_t next = (index + 1) & (capacity_ - 1);
+        while (dist_[next] > 1) {
+            new (&slots_[index]) Slot(std::move(slots_[next]));
+            slots_[next].~Slot();
+            dist_[index] = static_cast<std::uint8_t>(dist_[next] - 1);
+            index = next;
+            next = (next + 1) & (capacity_ - 1);
+        }
+        dist_[index] = 0;
+        --size_;
+        return true;
+    }
+
+    template <class Fn>
+    void ForEach(Fn&& fn) const {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (dist_[i] != 0) {
+                fn(slots_[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+    static constexpr std::size_t kMinCapacity = 16;
+    // dist_ is 1 + probe distance, 0 for an empty slot.
+    static constexpr std::uint8_t kMaxDist = 255;
+
+    std::size_t MaxSize(std::size_t capacity) const {
+        if (capacity == 0) {
+            return 0;
+        }
+        std::size_t limit = static_cast<std::size_t>(static_cast<double>(capacity) * max_load_factor_);
+        return limit < capacity ? limit : capacity - 1;
+    }
+
+    std::size_t Home(std::uint64_t hash) const {
+        return static_cast<std::size_t>(hash) & (capacity_ - 1);
+    }
+
+    template <class K>
+    std::size_t FindIndex(const K& key) const {
+        return capacity_ == 0 ? kNotFound : FindIndex(key, HashKey(hash_, key));
+    }
+
+    template <class K>
+    std::size_t FindIndex(const K& key, std::uint64_t hash) const {
+        std::size_t index = Home(hash);
+        // A size_t counter: no stored distance exceeds kMaxDist, so the loop
+        // ends at the latest after kMaxDist slots.
+        for (std::size_t dist = 1; dist_[index] >= dist; ++dist) {
+            if (dist_[index] == dist && equal_(slots_[index].key, key)) {
+                return index;
+            }
+            index = (index + 1) & (capacity_ - 1);
+        }
+        return kNotFound;
+    }
+
+    template <class K, class... Args>
+    std::pair<Slot*, bool> TryEmplace(K&& key, Args&&... args) {
+        std::uint64_t hash = HashKey(hash_, key);
+        if (capacity_ != 0) {
+            std::size_t found = FindIndex(key, hash);
+            if (found != kNotFound) {
+                return {&slots_[found], false};
+            }
+        }
+        if (size_ + 1 > MaxSize(capacity_)) {
+            Rehash(capacity_ == 0 ? kMinCapacity : capacity_ * 2);
+        }
+        // Make room before touching the arguments, so that a throw leaves
+        // them as they were.
+        std::size_t dist = 0;
+        std::size_t index = FindPlace(hash, dist);
+        while (index == kNotFound) {
+            if (size_ < MaxSize(capacity_) / 2) {
+                throw std::length_error("RobinHoodMap: too many keys with the same hash");
+            }
+            Rehash(capacity_ * 2);
+            index = FindPlace(hash, dist);
+        }
+        Slot slot{std::forward<K>(key), std::forward<Args>(args)...};
+        Place(index, dist, slot);
+        return {&slots_[index], true};
+    }
+
+    // Where a key with this hash, known to be absent, would go: at the first
+    // element richer than it (closer to its home), with its probe distance
+    // in dist. Returns kNotFound if that or a shifted element's distance
+    // would exceed kMaxDist.
+    std::size_t FindPlace(std::uint64_t hash, std::size_t& dist) const {
+        std::size_t mask = capacity_ - 1;
+        std::size_t index = Home(hash);
+        for (dist = 1; dist_[index] >= dist; ++dist) {
+            index = (index + 1) & mask;
+        }
+        if (dist > kMaxDist) {
+            return kNotFound;
+        }
+        for (std::size_t empty = index; dist_[empty] != 0; empty = (empty + 1) & mask) {
+            if (dist_[empty] == kMaxDist) {
+                return kNotFound;
+            }
+        }
+        return index;
+    }
+
+    // Shifts the cluster from index forward by one and moves slot in.
+    void Place(std::size_t index, std::size_t dist, Slot& slot) {
+        std::size_t mask = capacity_ - 1;
+        std::size_t empty = index;
+        while (dist_[empty] != 0) {
+            empty = (empty + 1) & mask;
+        }
+        for (std::size_t to = empty; to != index;) {
+            std::size_t from = (to - 1) & mask;
+            new (&slots_[to]) Slot(std::move(slots_[from]));
+            slots_[from].~Slot();
+            dist_[to] = static_cast<std::uint8_t>(dist_[from] + 1);
+            to = from;
+        }
+        new (&slots_[index]) Slot(std::move(slot));
+        dist_[index] = static_cast<std::uint8_t>(dist);
+        ++size_;
+    }
+
+    void Rehash(std::size_t capacity) {
+        std::vector<std::uint8_t> old_dist(capacity, 0);
+        old_dist.swap(dist_);
+        Slot* old_slots = slots_;
+        std::size_t old_capacity = capacity_;
+        slots_ = std::allocator<Slot>().allocate(capacity);
+        capacity_ = capacity;
+        size_ = 0;
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (old_dist[i] != 0) {
+                // Cannot fail: in a larger table no probe distance grows.
+                std::size_t dist = 0;
+                std::size_t index = FindPlace(HashKey(hash_, old_slots[i].key), dist);
+                assert(index != kNotFound);
+                Place(index, dist, old_slots[i]);
+                old_slots[i].~Slot();
+            }
+        }
+        if (old_slots != nullptr) {
+            std::allocator<Slot>().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void Destroy() {
+        if (slots_ == nullptr) {
+            return;
+        }
+        Clear();
+        std::allocator<Slot>().deallocate(slots_, capacity_);
+        slots_ = nullptr;
+        dist_.clear();
+        capacity_ = 0;
+    }
+
+    void Swap(RobinHoodMap& other) {
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+        std::swap(max_load_factor_, other.max_load_factor_);
+        dist_.swap(other.dist_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+    }
+
+    Hash hash_;
+    Equal equal_;
+    double max_load_factor_ = kDefaultMaxLoadFactor;
+    std::vector<std::uint8_t> dist_;
+    Slot* slots_ = nullptr;
+    std::size_t capacity_ = 0;  // power of two
+    std::size_t size_ = 0;
+};
+
+}  // namespace aisd
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <aisd/hash/swiss_table.h>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// Bump allocator for string bytes. Strings are copied into large blocks and
+// handed out as string_views that stay valid until Clear() or destruction;
+// nothing is freed individually.
+class StringArena {
+public:
+    explicit StringArena(std::size_t block_size = 1 << 16) : block_size_(block_size) {
+    }
+
+    std::string_view Store(std::string_view value) {
+        if (value.size() > left_) {
+            std::size_t size = value.size() > block_size_ ? value.size() : block_size_;
+            blocks_.emplace_back(new char[size]);
+            head_ = blocks_.back().get();
+            left_ = size;
+            reserved_ += size;
+        }
+        char* out = head_;
+        if (!value.empty()) {
+            std::memcpy(out, value.data(), value.size());
+        }
+        head_ += value.size();
+        left_ -= value.size();
+        used_ += value.size();
+        return {out, value.size()};
+    }
+
+    void Clear() {
+        blocks_.clear();
+        head_ = nullptr;
+        left_ = 0;
+        used_ = 0;
+        reserved_ = 0;
+    }
+
+    std::size_t BytesUsed() const {
+        return used_;
+    }
+
+    std::size_t BytesReserved() const {
+        return reserved_;
+    }
+
+private:
+    std::size_t block_size_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* head_ = nullptr;
+    std::size_t left_ = 0;
+    std::size_t used_ = 0;
+    std::size_t reserved_ = 0;
+};
+
+// String-keyed Swiss-table map whose keys live in a StringArena: slots are a
+// 16-byte string_view instead of a 32-byte std::string, inserting never
+// allocates per key, and key bytes of neighbouring insertions sit next to each
+// other. Erase drops the slot but not the key bytes.
+template <class Value, class Hash = std::hash<std::string_view>>
+class ArenaStringMap {
+    using Table = FlatHashMap<std::string_view, Value, Hash>;
+
+public:
+    explicit ArenaStringMap(double max_load_factor = Table::kDefaultMaxLoadFactor) : table_(max_load_factor) {
+    }
+
+    std::size_t Size() const {
+        return table_.Size();
+    }
+
+    bool Empty() const {
+        return table_.Empty();
+    }
+
+    void Reserve(std::size_t size) {
+        table_.Reserve(size);
+    }
+
+    void Clear() {
+        table_.Clear();
+        arena_.Clear();
+    }
+
+    // Returns false (and leaves the old value) if the key was present.
+    bool Insert(std::string_view key, Value value) {
+        return table_.LazyEmplace(key, [&] { return arena_.Store(key); }, std::move(value)).second;
+    }
+
+    Value& operator[](std::string_view key) {
+        return table_.LazyEmplace(key, [&] { return arena_.Store(key); }, Value()).first->value;
+    }
+
+    Value* FindValue(std::string_view key) {
+        return table_.FindValue(key);
+    }
+
+    const Value* FindValue(std::string_view key) const {
+        return table_.FindValue(key);
+    }
+
+    bool Contains(std::string_view key) const {
+        return table_.Contains(key);
+    }
+
+    bool Erase(std::string_view key) {
+        return table_.Erase(key);
+    }
+
+    template <class Fn>
+    void ForEach(Fn&& fn) const {
+        table_.ForEach(std::forward<Fn>(fn));
+    }
+
+    const StringArena& Arena() const {
+        return arena_;
+    }
+
+private:
+    Table table_;
+    StringArena arena_;
+};
+
+// Set counterpart of ArenaStringMap, e.g. for deduplicating lines.
+template <class Hash = std::hash<std::string_view>>
+class ArenaStringSet {
+    using Table = FlatHashSet<std::string_view, Hash>;
+
+public:
+    explicit ArenaStringSet(double max_load_factor = Table::kDefaultMaxLoadFactor) : table_(max_load_factor) {
+    }
+
+    std::size_t Size() const {
+        return table_.Size();
+    }
+
+    bool Empty() const {
+        return table_.Empty();
+    }
+
+    void Reserve(std::size_t size) {
+        table_.Reserve(size);
+    }
+
+    void Clear() {
+        table_.Clear();
+        arena_.Clear();
+    }
+
+    // Returns false if the key was present.
+    bool Insert(std::string_view key) {
+        return table_.LazyEmplace(key, [&] { return arena_.Store(key); }).second;
+    }
+
+    bool Contains(std::string_view key) const {
+        return table_.Contains(key);
+    }
+
+    bool Erase(std::string_view key) {
+        return table_.Erase(key);
+    }
+
+    template <class Fn>
+    void ForEach(Fn&& fn) const {
+        table_.ForEach([&fn](const auto& slot) { fn(slot.key); });
+    }
+
+    const StringArena& Arena() const {
+        return arena_;
+    }
+
+private:
+    Table table_;
+    StringArena arena_;
+};
+
+}  // namespace aisd
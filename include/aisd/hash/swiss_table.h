@@ -0,0 +1,443 @@
+#pragma once
+
+#include <aisd/hash/hash.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace aisd {
+
+namespace hash_detail {
+
+// Control byte per slot: kEmpty, kDeleted (tombstone) or, for a full slot, the
+// low 7 bits of the key's hash.
+inline constexpr std::int8_t kEmpty = -128;
+inline constexpr std::int8_t kDeleted = -2;
+inline constexpr std::size_t kGroupSize = 16;
+
+// Bit i of a mask is set when control byte i of the group matches.
+class Group {
+public:
+    explicit Group(const std::int8_t* ctrl) {
+#if defined(__SSE2__)
+        ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        std::memcpy(ctrl_, ctrl, kGroupSize);
+#endif
+    }
+
+    std::uint32_t Match(std::int8_t tag) const {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl_)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kGroupSize; ++i) {
+            mask |= static_cast<std::uint32_t>(ctrl_[i] == tag) << i;
+        }
+        return mask;
+#endif
+    }
+
+    std::uint32_t MatchEmpty() const {
+        return Match(kEmpty);
+    }
+
+    // Empty and deleted are the only negative control bytes.
+    std::uint32_t MatchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kGroupSize; ++i) {
+            mask |= static_cast<std::uint32_t>(ctrl_[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i ctrl_;
+#else
+    std::int8_t ctrl_[kGroupSize];
+#endif
+};
+
+inline std::size_t LowestBit(std::uint32_t mask) {
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+}
+
+template <class Key, class Value>
+struct MapSlot {
+    Key key;
+    Value value;
+};
+
+template <class Key>
+struct SetSlot {
+    Key key;
+};
+
+// Open-addressing table in the style of Abseil's Swiss tables.
+//
+// Slots are split into aligned groups of 16 with one control byte each. A
+// lookup hashes once, jumps to a group by the high bits and compares the 7-bit
+// tag against all 16 control bytes with one SSE2 compare; only tag hits touch
+// the slot array, so a miss usually costs a single cache line of metadata.
+// Groups are probed quadratically (triangular numbers), which visits every
+// group of the power-of-two table. Erase leaves a tombstone only if the group
+// is full, since a probe would have stopped at any group with an empty slot.
+template <class Slot, class Hash, class Equal>
+class SwissTable {
+public:
+    // Default maximum load factor and the one used by compact tables.
+    static constexpr double kDefaultMaxLoadFactor = 0.875;
+    static constexpr double kCompactMaxLoadFactor = 0.97;
+
+    explicit SwissTable(double max_load_factor = kDefaultMaxLoadFactor, Hash hash = Hash(), Equal equal = Equal())
+        : hash_(std::move(hash)), equal_(std::move(equal)), max_load_factor_(max_load_factor) {
+        assert(max_load_factor > 0 && max_load_factor < 1);
+    }
+
+    SwissTable(const SwissTable&) = delete;
+    SwissTable& operator=(const SwissTable&) = delete;
+
+    SwissTable(SwissTable&& other) noexcept {
+        Swap(other);
+    }
+
+    SwissTable& operator=(SwissTable&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    ~SwissTable() {
+        Destroy();
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    std::size_t Capacity() const {
+        return capacity_;
+    }
+
+    double MaxLoadFactor() const {
+        return max_load_factor_;
+    }
+
+    void Clear() {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].~Slot();
+            }
+        }
+        std::fill(ctrl_.begin(), ctrl_.end(), kEmpty);
+        size_ = 0;
+        growth_left_ = MaxSize(capacity_);
+    }
+
+    // Makes room for `size` elements without further rehashing.
+    void Reserve(std::size_t size) {
+        std::size_t capacity = capacity_ == 0 ? kGroupSize : capacity_;
+        while (MaxSize(capacity) < size) {
+            capacity *= 2;
+        }
+        if (capacity != capacity_) {
+            Rehash(capacity);
+        }
+    }
+
+    template <class K>
+    Slot* Find(const K& key) {
+        std::size_t index = FindIndex(key, HashKey(hash_, key));
+        return index == kNotFound ? nullptr : &slots_[index];
+    }
+
+    template <class K>
+    const Slot* Find(const K& key) const {
+        return const_cast<SwissTable*>(this)->Find(key);
+    }
+
+    // Finds the key or constructs Slot{key, args...} in place; the bool is
+    // true if the slot is new.
+    template <class K, class... Args>
+    std::pair<Slot*, bool> TryEmplace(K&& key, Args&&... args) {
+        std::uint64_t hash = HashKey(hash_, key);
+        std::size_t index = FindIndex(key, hash);
+        if (index != kNotFound) {
+            return {&slots_[index], false};
+        }
+        index = PrepareInsert(hash);
+        new (&slots_[index]) Slot{std::forward<K>(key), std::forward<Args>(args)...};
+        CommitInsert(index, hash);
+        return {&slots_[index], true};
+    }
+
+    // Like TryEmplace, but the stored key is make_key() and is only built
+    // when the lookup by `key` misses (e.g. to copy it into an arena).
+    template <class K, class MakeKey, class... Args>
+    std::pair<Slot*, bool> LazyEmplace(const K& key, MakeKey&& make_key, Args&&... args) {
+        std::uint64_t hash = HashKey(hash_, key);
+        std::size_t index = FindIndex(key, hash);
+        if (index != kNotFound) {
+            return {&slots_[index], false};
+        }
+        index = PrepareInsert(hash);
+        new (&slots_[index]) Slot{make_key(), std::forward<Args>(args)...};
+        CommitInsert(index, hash);
+        return {&slots_[index], true};
+    }
+
+    template <class K>
+    bool Erase(const K& key) {
+        std::size_t index = FindIndex(key, HashKey(hash_, key));
+        if (index == kNotFound) {
+            return false;
+        }
+        slots_[index].~Slot();
+        --size_;
+        std::size_t group = index & ~(kGroupSize - 1);
+        if (Group(&ctrl_[group]).MatchEmpty() != 0) {
+            ctrl_[index] = kEmpty;
+            ++growth_left_;
+        } else {
+            ctrl_[index] = kDeleted;
+        }
+        return true;
+    }
+
+    template <class Fn>
+    void ForEach(Fn&& fn) const {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                fn(slots_[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+    static std::int8_t Tag(std::uint64_t hash) {
+        return static_cast<std::int8_t>(hash & 0x7f);
+    }
+
+    std::size_t FirstGroup(std::uint64_t hash) const {
+        return static_cast<std::size_t>(hash >> 7) & (capacity_ - 1) & ~(kGroupSize - 1);
+    }
+
+    // Largest number of elements (tombstones included) a table of the given
+    // capacity takes before it rehashes; always leaves one slot empty.
+    std::size_t MaxSize(std::size_t capacity) const {
+        if (capacity == 0) {
+            return 0;
+        }
+        std::size_t limit = static_cast<std::size_t>(static_cast<double>(capacity) * max_load_factor_);
+        return limit < capacity ? limit : capacity - 1;
+    }
+
+    template <class K>
+    std::size_t FindIndex(const K& key, std::uint64_t hash) const {
+        if (capacity_ == 0) {
+            return kNotFound;
+        }
+        std::int8_t tag = Tag(hash);
+        std::size_t group = FirstGroup(hash);
+        for (std::size_t step = kGroupSize;; step += kGroupSize) {
+            Group g(&ctrl_[group]);
+            for (std::uint32_t mask = g.Match(tag); mask != 0; mask &= mask - 1) {
+                std::size_t index = group + LowestBit(mask);
+                if (equal_(slots_[index].key, key)) {
+                    return index;
+                }
+            }
+            if (g.MatchEmpty() != 0) {
+                return kNotFound;
+            }
+            group = (group + step) & (capacity_ - 1);
+        }
+    }
+
+    std::size_t FindInsertSlot(std::uint64_t hash) const {
+        std::size_t group = FirstGroup(hash);
+        for (std::size_t step = kGroupSize;; step += kGroupSize) {
+            std::uint32_t mask = Group(&ctrl_[group]).MatchEmptyOrDeleted();
+            if (mask != 0) {
+                return group + LowestBit(mask);
+            }
+            group = (group + step) & (capacity_ - 1);
+        }
+    }
+
+    // Returns a free slot for the hash, rehashing first if needed. The slot
+    // only counts as full after CommitInsert, so a Slot constructor that
+    // throws in between leaves the table consistent.
+    std::size_t PrepareInsert(std::uint64_t hash) {
+        if (capacity_ == 0) {
+            Rehash(kGroupSize);
+        }
+        std::size_t index = FindInsertSlot(hash);
+        if (growth_left_ == 0 && ctrl_[index] == kEmpty) {
+            // Out of empty slots: drop tombstones if they are what fills the
+            // table, grow otherwise.
+            Rehash(size_ + 1 <= MaxSize(capacity_) / 2 ? capacity_ : capacity_ * 2);
+            index = FindInsertSlot(hash);
+        }
+        return index;
+    }
+
+    void CommitInsert(std::size_t index, std::uint64_t hash) {
+        if (ctrl_[index] == kEmpty) {
+            --growth_left_;
+        }
+        ctrl_[index] = Tag(hash);
+        ++size_;
+    }
+
+    void Rehash(std::size_t capacity) {
+        std::vector<std::int8_t> old_ctrl(capacity, kEmpty);
+        old_ctrl.swap(ctrl_);
+        Slot* old_slots = slots_;
+        std::size_t old_capacity = capacity_;
+        slots_ = std::allocator<Slot>().allocate(capacity);
+        capacity_ = capacity;
+        growth_left_ = MaxSize(capacity) - size_;
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] < 0) {
+                continue;
+            }
+            std::uint64_t hash = HashKey(hash_, old_slots[i].key);
+            std::size_t index = FindInsertSlot(hash);
+            ctrl_[index] = Tag(hash);
+            new (&slots_[index]) Slot(std::move(old_slots[i]));
+            old_slots[i].~Slot();
+        }
+        if (old_slots != nullptr) {
+            std::allocator<Slot>().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void Destroy() {
+        if (slots_ == nullptr) {
+            return;
+        }
+        Clear();
+        std::allocator<Slot>().deallocate(slots_, capacity_);
+        slots_ = nullptr;
+        ctrl_.clear();
+        capacity_ = 0;
+        growth_left_ = 0;
+    }
+
+    void Swap(SwissTable& other) {
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+        std::swap(max_load_factor_, other.max_load_factor_);
+        ctrl_.swap(other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+    }
+
+    Hash hash_;
+    Equal equal_;
+    double max_load_factor_ = kDefaultMaxLoadFactor;
+    std::vector<std::int8_t> ctrl_;
+    Slot* slots_ = nullptr;
+    std::size_t capacity_ = 0;  // power of two, multiple of kGroupSize
+    std::size_t size_ = 0;
+    std::size_t growth_left_ = 0;  // empty slots that may still be filled
+};
+
+}  // namespace hash_detail
+
+// Hash map with Swiss-table probing. Pass
+// FlatHashMap::kCompactMaxLoadFactor to the constructor to trade a few
+// extra probes for ~10% less memory.
+template <class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<>>
+class FlatHashMap : public hash_detail::SwissTable<hash_detail::MapSlot<Key, Value>, Hash, Equal> {
+    using Base = hash_detail::SwissTable<hash_detail::MapSlot<Key, Value>, Hash, Equal>;
+
+public:
+    using Base::Base;
+
+    // Returns false (and leaves the old value) if the key was present.
+    template <class K, class V>
+    bool Insert(K&& key, V&& value) {
+        return this->TryEmplace(std::forward<K>(key), std::forward<V>(value)).second;
+    }
+
+    template <class K>
+    void InsertOrAssign(K&& key, Value value) {
+        auto [slot, inserted] = this->TryEmplace(std::forward<K>(key), value);
+        if (!inserted) {
+            slot->value = std::move(value);
+        }
+    }
+
+    template <class K>
+    Value& operator[](K&& key) {
+        return this->TryEmplace(std::forward<K>(key), Value()).first->value;
+    }
+
+    template <class K>
+    Value* FindValue(const K& key) {
+        auto* slot = this->Find(key);
+        return slot == nullptr ? nullptr : &slot->value;
+    }
+
+    template <class K>
+    const Value* FindValue(const K& key) const {
+        auto* slot = this->Find(key);
+        return slot == nullptr ? nullptr : &slot->value;
+    }
+
+    template <class K>
+    bool Contains(const K& key) const {
+        return this->Find(key) != nullptr;
+    }
+};
+
+// Hash set with Swiss-table probing; slots hold the bare key.
+template <class Key, class Hash = std::hash<Key>, class Equal = std::equal_to<>>
+class FlatHashSet : public hash_detail::SwissTable<hash_detail::SetSlot<Key>, Hash, Equal> {
+    using Base = hash_detail::SwissTable<hash_detail::SetSlot<Key>, Hash, Equal>;
+
+public:
+    using Base::Base;
+
+    // Returns false if the key was present.
+    template <class K>
+    bool Insert(K&& key) {
+        return this->TryEmplace(std::forward<K>(key)).second;
+    }
+
+    template <class K>
+    bool Contains(const K& key) const {
+        return this->Find(key) != nullptr;
+    }
+};
+
+}  // namespace aisd
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <aisd/heap/handle.h>
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// Implicit D-ary min-heap (with respect to Compare) with decrease-key.
+//
+// Keys live inline in one array next to their handles, so sifting touches a
+// single cache line per level for small keys and D = 4..8. A second array maps
+// handles to positions. After Reserve(n) no operation allocates as long as at
+// most n elements are alive at once.
+template <class Key, unsigned D = 4, class Compare = std::less<Key>>
+class DAryHeap {
+    static_assert(D >= 2, "arity must be at least 2");
+
+public:
+    explicit DAryHeap(Compare compare = Compare()) : compare_(std::move(compare)) {
+    }
+
+    void Reserve(std::size_t capacity) {
+        heap_.reserve(capacity);
+        pos_.reserve(capacity);
+        free_.reserve(capacity);
+    }
+
+    std::size_t Size() const {
+        return heap_.size();
+    }
+
+    bool Empty() const {
+        return heap_.empty();
+    }
+
+    void Clear() {
+        heap_.clear();
+        pos_.clear();
+        free_.clear();
+    }
+
+    HeapHandle Push(Key key) {
+        HeapHandle handle;
+        if (free_.empty()) {
+            handle = static_cast<HeapHandle>(pos_.size());
+            pos_.push_back(0);
+        } else {
+            handle = free_.back();
+            free_.pop_back();
+        }
+        heap_.push_back({std::move(key), handle});
+        SiftUp(heap_.size() - 1);
+        return handle;
+    }
+
+    const Key& Top() const {
+        assert(!Empty());
+        return heap_.front().key;
+    }
+
+    HeapHandle TopHandle() const {
+        assert(!Empty());
+        return heap_.front().handle;
+    }
+
+    void Pop() {
+        assert(!Empty());
+        RemoveAt(0);
+    }
+
+    bool Contains(HeapHandle handle) const {
+        return handle < pos_.size() && pos_[handle] != kNone;
+    }
+
+    const Key& KeyOf(HeapHandle handle) const {
+        assert(Contains(handle));
+        return heap_[pos_[handle]].key;
+    }
+
+    // The new key must not compare greater than the current one.
+    void DecreaseKey(HeapHandle handle, Key key) {
+        assert(Contains(handle));
+        std::size_t index = pos_[handle];
+        assert(!compare_(heap_[index].key, key));
+        heap_[index].key = std::move(key);
+        SiftUp(index);
+    }
+
+    void Erase(HeapHandle handle) {
+        assert(Contains(handle));
+        RemoveAt(pos_[handle]);
+    }
+
+private:
+    static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+    struct Entry {
+        Key key;
+        HeapHandle handle;
+    };
+
+    void RemoveAt(std::size_t index) {
+        pos_[heap_[index].handle] = kNone;
+        free_.push_back(heap_[index].handle);
+        Entry last = std::move(heap_.back());
+        heap_.pop_back();
+        if (index == heap_.size()) {
+            return;
+        }
+        heap_[index] = std::move(last);
+        pos_[heap_[index].handle] = index;
+        if (index > 0 && compare_(heap_[index].key, heap_[(index - 1) / D].key)) {
+            SiftUp(index);
+        } else {
+            SiftDown(index);
+        }
+    }
+
+    // Both sifts move a hole instead of swapping, writing each entry once.
+    void SiftUp(std::size_t index) {
+        Entry entry = std::move(heap_[index]);
+        while (index > 0) {
+            std::size_t parent = (index - 1) / D;
+            if (!compare_(entry.key, heap_[parent].key)) {
+                break;
+            }
+            heap_[index] = std::move(heap_[parent]);
+            pos_[heap_[index].handle] = index;
+            index = parent;
+        }
+        pos_[entry.handle] = index;
+        heap_[index] = std::move(entry);
+    }
+
+    void SiftDown(std::size_t index) {
+        std::size_t size = heap_.size();
+        Entry entry = std::move(heap_[index]);
+        while (true) {
+            std::size_t first = index * D + 1;
+            if (first >= size) {
+                break;
+            }
+            std::size_t last = first + D < size ? first + D : size;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child) {
+                if (compare_(heap_[child].key, heap_[best].key)) {
+                    best = child;
+                }
+            }
+            if (!compare_(heap_[best].key, entry.key)) {
+                break;
+            }
+            heap_[index] = std::move(heap_[best]);
+            pos_[heap_[index].handle] = index;
+            index = best;
+        }
+        pos_[entry.handle] = index;
+        heap_[index] = std::move(entry);
+    }
+
+    Compare compare_;
+    std::vector<Entry> heap_;
+    std::vector<std::size_t> pos_;  // handle -> index in heap_, kNone if free
+    std::vector<HeapHandle> free_;
+};
+
+}  // namespace aisd
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace aisd {
+
+// Stable identifier of an element in an addressable heap. A handle stays valid
+// from Push() until the element leaves the heap (Pop() or Erase()); after that
+// the heap may hand the same value out again.
+using HeapHandle = std::uint32_t;
+
+inline constexpr HeapHandle kInvalidHeapHandle = std::numeric_limits<HeapHandle>::max();
+
+}  // namespace aisd
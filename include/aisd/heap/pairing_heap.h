@@ -0,0 +1,217 @@
+#pragma once
+
+#include <aisd/heap/handle.h>
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// Pairing min-heap (with respect to Compare) whose nodes live in a pool.
+//
+// Nodes are addressed by 32-bit indices into one vector and recycled through a
+// free list, so Push/Pop/DecreaseKey never allocate after Reserve(n) while at
+// most n elements are alive. DecreaseKey is O(1), Pop is amortized O(log n).
+// Handles are node indices.
+template <class Key, class Compare = std::less<Key>>
+class PairingHeap {
+public:
+    explicit PairingHeap(Compare compare = Compare()) : compare_(std::move(compare)) {
+    }
+
+    void Reserve(std::size_t capacity) {
+        nodes_.reserve(capacity);
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    void Clear() {
+        nodes_.clear();
+        root_ = kNil;
+        free_ = kNil;
+        size_ = 0;
+    }
+
+    HeapHandle Push(Key key) {
+        HeapHandle node = NewNode(std::move(key));
+        root_ = root_ == kNil ? node : Link(root_, node);
+        ++size_;
+        return node;
+    }
+
+    const Key& Top() const {
+        assert(!Empty());
+        return nodes_[root_].key;
+    }
+
+    HeapHandle TopHandle() const {
+        assert(!Empty());
+        return root_;
+    }
+
+    void Pop() {
+        assert(!Empty());
+        HeapHandle old_root = root_;
+        root_ = CombineChildren(old_root);
+        if (root_ != kNil) {
+            nodes_[root_].prev = kNil;
+        }
+        FreeNode(old_root);
+        --size_;
+    }
+
+    bool Contains(HeapHandle handle) const {
+        return handle < nodes_.size() && nodes_[handle].alive;
+    }
+
+    const Key& KeyOf(HeapHandle handle) const {
+        assert(Contains(handle));
+        return nodes_[handle].key;
+    }
+
+    // The new key must not compare greater than the current one.
+    void DecreaseKey(HeapHandle handle, Key key) {
+        assert(Contains(handle));
+        assert(!compare_(nodes_[handle].key, key));
+        nodes_[handle].key = std::move(key);
+        if (handle == root_) {
+            return;
+        }
+        Cut(handle);
+        root_ = Link(root_, handle);
+    }
+
+    void Erase(HeapHandle handle) {
+        assert(Contains(handle));
+        if (handle == root_) {
+            Pop();
+            return;
+        }
+        Cut(handle);
+        HeapHandle subtree = CombineChildren(handle);
+        if (subtree != kNil) {
+            nodes_[subtree].prev = kNil;
+            root_ = Link(root_, subtree);
+        }
+        FreeNode(handle);
+        --size_;
+    }
+
+private:
+    static constexpr HeapHandle kNil = kInvalidHeapHandle;
+
+    struct Node {
+        Key key;
+        HeapHandle child = kNil;
+        HeapHandle sibling = kNil;  // next sibling; next free node for free ones
+        HeapHandle prev = kNil;     // parent if leftmost child, else left sibling
+        bool alive = false;
+    };
+
+    HeapHandle NewNode(Key key) {
+        HeapHandle node;
+        if (free_ != kNil) {
+            node = free_;
+            free_ = nodes_[node].sibling;
+            nodes_[node].key = std::move(key);
+        } else {
+            node = static_cast<HeapHandle>(nodes_.size());
+            nodes_.push_back({std::move(key)});
+        }
+        Node& n = nodes_[node];
+        n.child = n.sibling = n.prev = kNil;
+        n.alive = true;
+        return node;
+    }
+
+    void FreeNode(HeapHandle node) {
+        nodes_[node].alive = false;
+        nodes_[node].sibling = free_;
+        free_ = node;
+    }
+
+    // Links two roots; the loser becomes the leftmost child of the winner.
+    HeapHandle Link(HeapHandle a, HeapHandle b) {
+        if (compare_(nodes_[b].key, nodes_[a].key)) {
+            std::swap(a, b);
+        }
+        Node& winner = nodes_[a];
+        Node& loser = nodes_[b];
+        loser.prev = a;
+        loser.sibling = winner.child;
+        if (winner.child != kNil) {
+            nodes_[winner.child].prev = b;
+        }
+        winner.child = b;
+        winner.sibling = kNil;
+        winner.prev = kNil;
+        return a;
+    }
+
+    // Detaches the subtree rooted at node from its parent.
+    void Cut(HeapHandle node) {
+        Node& n = nodes_[node];
+        Node& prev = nodes_[n.prev];
+        if (prev.child == node) {
+            prev.child = n.sibling;
+        } else {
+            prev.sibling = n.sibling;
+        }
+        if (n.sibling != kNil) {
+            nodes_[n.sibling].prev = n.prev;
+        }
+        n.prev = n.sibling = kNil;
+    }
+
+    // Standard two-pass pairing of the children of node: pair them left to
+    // right, then fold the pairs right to left. The intermediate list is
+    // threaded through the sibling links, so no scratch memory is needed.
+    HeapHandle CombineChildren(HeapHandle node) {
+        HeapHandle current = nodes_[node].child;
+        nodes_[node].child = kNil;
+        HeapHandle pairs = kNil;  // reversed list of paired trees
+        while (current != kNil) {
+            HeapHandle first = current;
+            HeapHandle second = nodes_[first].sibling;
+            if (second == kNil) {
+                nodes_[first].prev = kNil;
+                nodes_[first].sibling = pairs;
+                pairs = first;
+                break;
+            }
+            current = nodes_[second].sibling;
+            HeapHandle merged = Link(first, second);
+            nodes_[merged].sibling = pairs;
+            pairs = merged;
+        }
+        if (pairs == kNil) {
+            return kNil;
+        }
+        HeapHandle result = pairs;
+        HeapHandle next = nodes_[result].sibling;
+        nodes_[result].sibling = kNil;
+        while (next != kNil) {
+            HeapHandle tree = next;
+            next = nodes_[tree].sibling;
+            result = Link(result, tree);
+        }
+        return result;
+    }
+
+    Compare compare_;
+    std::vector<Node> nodes_;
+    HeapHandle root_ = kNil;
+    HeapHandle free_ = kNil;
+    std::size_t size_ = 0;
+};
+
+}  // namespace aisd
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <aisd/heap/handle.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace aisd {
+
+// Radix heap for monotone unsigned integer keys: every pushed (or decreased)
+// key must be >= the last popped minimum, as in Dijkstra with non-negative
+// weights.
+//
+// Bucket i holds keys whose highest bit differing from the last minimum is
+// bit i - 1, so each element moves to strictly lower buckets at most
+// bit-width times over its lifetime. Buckets are contiguous vectors of handles
+// (an intrusive-list variant is ~3x slower on 1e6 keys because redistribution
+// turns into pointer chasing); they keep their capacity across Pop() and
+// Clear(), so a warmed-up heap does not allocate. Element data lives in a
+// handle-indexed slot table to support DecreaseKey/Erase.
+template <class Key>
+class RadixHeap {
+    static_assert(std::is_unsigned_v<Key>, "radix heap keys must be unsigned integers");
+
+public:
+    // Buckets are not pre-sized (each may briefly hold every element); they
+    // grow geometrically on first use, O(log n) allocations per bucket.
+    void Reserve(std::size_t capacity) {
+        slots_.reserve(capacity);
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    void Clear() {
+        for (auto& bucket : buckets_) {
+            bucket.clear();
+        }
+        slots_.clear();
+        free_ = kInvalidHeapHandle;
+        size_ = 0;
+        last_ = 0;
+    }
+
+    // Smallest key popped so far; lower bound for further pushes.
+    Key LastMin() const {
+        return last_;
+    }
+
+    HeapHandle Push(Key key) {
+        assert(key >= last_);
+        HeapHandle handle;
+        if (free_ != kInvalidHeapHandle) {
+            handle = free_;
+            free_ = slots_[handle].index;
+        } else {
+            handle = static_cast<HeapHandle>(slots_.size());
+            slots_.push_back({});
+        }
+        slots_[handle].key = key;
+        Insert(handle);
+        ++size_;
+        return handle;
+    }
+
+    Key Top() {
+        Settle();
+        return slots_[buckets_[0].back()].key;
+    }
+
+    HeapHandle TopHandle() {
+        Settle();
+        return buckets_[0].back();
+    }
+
+    void Pop() {
+        Settle();
+        HeapHandle handle = buckets_[0].back();
+        buckets_[0].pop_back();
+        Release(handle);
+    }
+
+    bool Contains(HeapHandle handle) const {
+        return handle < slots_.size() && slots_[handle].bucket != kFree;
+    }
+
+    Key KeyOf(HeapHandle handle) const {
+        assert(Contains(handle));
+        return slots_[handle].key;
+    }
+
+    // last popped minimum <= key <= current key.
+    void DecreaseKey(HeapHandle handle, Key key) {
+        assert(Contains(handle));
+        assert(key >= last_ && key <= slots_[handle].key);
+        Unlink(handle);
+        slots_[handle].key = key;
+        Insert(handle);
+    }
+
+    void Erase(HeapHandle handle) {
+        assert(Contains(handle));
+        Unlink(handle);
+        Release(handle);
+    }
+
+private:
+    static constexpr std::size_t kBits = std::numeric_limits<Key>::digits;
+    static constexpr std::uint8_t kFree = 0xff;
+
+    struct Slot {
+        Key key = 0;
+        std::uint32_t index = 0;  // position in bucket; next free slot if free
+        std::uint8_t bucket = kFree;
+    };
+
+    static std::size_t BucketOf(Key key, Key last) {
+        Key diff = key ^ last;
+        if (diff == 0) {
+            return 0;
+        }
+        if constexpr (kBits <= 32) {
+            return 32 - static_cast<std::size_t>(__builtin_clz(static_cast<std::uint32_t>(diff)));
+        } else {
+            return 64 - static_cast<std::size_t>(__builtin_clzll(static_cast<std::uint64_t>(diff)));
+        }
+    }
+
+    void Insert(HeapHandle handle) {
+        Slot& slot = slots_[handle];
+        slot.bucket = static_cast<std::uint8_t>(BucketOf(slot.key, last_));
+        auto& bucket = buckets_[slot.bucket];
+        slot.index = static_cast<std::uint32_t>(bucket.size());
+        bucket.push_back(handle);
+    }
+
+    void Unlink(HeapHandle handle) {
+        Slot& slot = slots_[handle];
+        auto& bucket = buckets_[slot.bucket];
+        HeapHandle moved = bucket.back();
+        bucket[slot.index] = moved;
+        slots_[moved].index = slot.index;
+        bucket.pop_back();
+    }
+
+    void Release(HeapHandle handle) {
+        slots_[handle].bucket = kFree;
+        slots_[handle].index = free_;
+        free_ = handle;
+        --size_;
+    }
+
+    // Makes bucket 0 non-empty by redistributing the first non-empty bucket
+    // around its minimum. Every element lands in a bucket below i, so the
+    // source vector is not reallocated while it is being walked.
+    void Settle() {
+        assert(!Empty());
+        if (!buckets_[0].empty()) {
+            return;
+        }
+        std::size_t i = 1;
+        while (buckets_[i].empty()) {
+            ++i;
+        }
+        auto& source = buckets_[i];
+        Key min = slots_[source[0]].key;
+        for (HeapHandle handle : source) {
+            if (slots_[handle].key < min) {
+                min = slots_[handle].key;
+            }
+        }
+        last_ = min;
+        for (HeapHandle handle : source) {
+            Insert(handle);
+        }
+        source.clear();
+    }
+
+    std::vector<HeapHandle> buckets_[kBits + 1];
+    std::vector<Slot> slots_;
+    HeapHandle free_ = kInvalidHeapHandle;
+    std::size_t size_ = 0;
+    Key last_ = 0;
+};
+
+}  // namespace aisd
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace aisd {
+
+// Number of worker threads to use when the caller passes 0 ("auto").
+inline unsigned ResolveThreads(unsigned threads) {
+    if (threads != 0) {
+        return threads;
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+// Calls fn(task) for every task in [0, tasks) using up to `threads` threads
+// (the calling thread included). Tasks are handed out in contiguous blocks;
+// use it for coarse-grained, evenly sized work.
+template <class Fn>
+void ParallelFor(std::size_t tasks, unsigned threads, Fn&& fn) {
+    threads = static_cast<unsigned>(std::min<std::size_t>(ResolveThreads(threads), tasks));
+    if (threads <= 1) {
+        for (std::size_t task = 0; task < tasks; ++task) {
+            fn(task);
+        }
+        return;
+    }
+    auto worker = [&](unsigned id) {
+        std::size_t begin = tasks * id / threads;
+        std::size_t end = tasks * (id + 1) / threads;
+        for (std::size_t task = begin; task < end; ++task) {
+            fn(task);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+}  // namespace aisd
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace aisd {
+
+namespace sort_detail {
+
+inline constexpr std::ptrdiff_t kInsertionSortThreshold = 24;
+inline constexpr std::ptrdiff_t kNintherThreshold = 128;
+inline constexpr std::ptrdiff_t kBlockSize = 64;
+
+template <class It, class Compare>
+void InsertionSort(It first, It last, Compare comp) {
+    if (first == last) {
+        return;
+    }
+    for (It current = first + 1; current != last; ++current) {
+        if (!comp(*current, *(current - 1))) {
+            continue;
+        }
+        auto value = std::move(*current);
+        It hole = current;
+        do {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while (hole != first && comp(value, *(hole - 1)));
+        *hole = std::move(value);
+    }
+}
+
+template <class It, class Compare>
+void Sort3(It a, It b, It c, Compare comp) {
+    if (comp(*b, *a)) {
+        std::iter_swap(a, b);
+    }
+    if (comp(*c, *b)) {
+        std::iter_swap(b, c);
+        if (comp(*b, *a)) {
+            std::iter_swap(a, b);
+        }
+    }
+}
+
+// Moves the median of three (or Tukey's ninther for large ranges) to *first.
+template <class It, class Compare>
+void ChoosePivot(It first, It last, Compare comp) {
+    std::ptrdiff_t size = last - first;
+    std::ptrdiff_t half = size / 2;
+    if (size > kNintherThreshold) {
+        Sort3(first, first + half, last - 1, comp);
+        Sort3(first + 1, first + (half - 1), last - 2, comp);
+        Sort3(first + 2, first + (half + 1), last - 3, comp);
+        Sort3(first + (half - 1), first + half, first + (half + 1), comp);
+        std::iter_swap(first, first + half);
+    } else {
+        Sort3(first + half, first, last - 1, comp);
+    }
+}
+
+// Classic Hoare pass over [first, last): afterwards everything left of the
+// returned iterator is < pivot and everything right of it is >= pivot.
+template <class It, class T, class Compare>
+It HoarePartition(It first, It last, const T& pivot, Compare comp) {
+    while (true) {
+        while (first < last && comp(*first, pivot)) {
+            ++first;
+        }
+        while (first < last && !comp(*(last - 1), pivot)) {
+            --last;
+        }
+        if (first >= last) {
+            return first;
+        }
+        std::iter_swap(first, last - 1);
+        ++first;
+        --last;
+    }
+}
+
+// Block partition of Edelkamp and Weiss ("BlockQuicksort: How Branch
+// Mispredictions don't affect Quicksort"). The pivot is *first; elements
+// < pivot end up left of the returned position, which holds the pivot.
+//
+// Comparisons only write offsets into small buffers (the comparison result is
+// added to a counter instead of being branched on); the swaps are then done in
+// a separate loop whose trip count does not depend on the data. Leftover
+// elements (at most 2 blocks) go through HoarePartition.
+template <class It, class Compare>
+It PartitionRightBranchless(It first, It last, Compare comp) {
+    auto pivot = std::move(*first);
+    It begin = first;
+    ++first;
+
+    unsigned char offsets_l[kBlockSize];
+    unsigned char offsets_r[kBlockSize];
+    std::ptrdiff_t num_l = 0;
+    std::ptrdiff_t num_r = 0;
+    std::ptrdiff_t start_l = 0;
+    std::ptrdiff_t start_r = 0;
+    while (last - first > 2 * kBlockSize) {
+        if (num_l == 0) {
+            start_l = 0;
+            It it = first;
+            for (std::ptrdiff_t i = 0; i < kBlockSize; ++i, ++it) {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !comp(*it, pivot);
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            It it = last;
+            for (std::ptrdiff_t i = 0; i < kBlockSize; ++i) {
+                --it;
+                offsets_r[num_r] = static_cast<unsigned char>(i);
+                num_r += comp(*it, pivot);
+            }
+        }
+        std::ptrdiff_t num = std::min(num_l, num_r);
+        for (std::ptrdiff_t k = 0; k < num; ++k) {
+            std::iter_swap(first + offsets_l[start_l + k], last - 1 - offsets_r[start_r + k]);
+        }
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) {
+            first += kBlockSize;
+        }
+        if (num_r == 0) {
+            last -= kBlockSize;
+        }
+    }
+    It pivot_pos = HoarePartition(first, last, pivot, comp) - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+// Used when the pivot equals its left neighbour, i.e. the range starts with a
+// run of elements equal to the pivot: puts every element <= pivot left of the
+// returned position so the whole run is skipped at once. Keeps inputs with
+// few distinct keys O(n log k).
+template <class It, class Compare>
+It PartitionLeft(It first, It last, Compare comp) {
+    auto pivot = std::move(*first);
+    It begin = first;
+    ++first;
+    while (true) {
+        while (first < last && !comp(pivot, *first)) {
+            ++first;
+        }
+        while (first < last && comp(pivot, *(last - 1))) {
+            --last;
+        }
+        if (first >= last) {
+            break;
+        }
+        std::iter_swap(first, last - 1);
+        ++first;
+        --last;
+    }
+    It pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+template <class It, class Compare>
+void BlockQuicksortLoop(It first, It last, Compare comp, int bad_allowed, bool leftmost) {
+    while (true) {
+        std::ptrdiff_t size = last - first;
+        if (size < kInsertionSortThreshold) {
+            InsertionSort(first, last, comp);
+            return;
+        }
+        ChoosePivot(first, last, comp);
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = PartitionLeft(first, last, comp) + 1;
+            continue;
+        }
+        It pivot_pos = PartitionRightBranchless(first, last, comp);
+        std::ptrdiff_t left_size = pivot_pos - first;
+        std::ptrdiff_t right_size = last - pivot_pos - 1;
+        if (left_size < size / 8 || right_size < size / 8) {
+            if (--bad_allowed == 0) {
+                std::make_heap(first, last, comp);
+                std::sort_heap(first, last, comp);
+                return;
+            }
+        }
+        // Recurse into the smaller side to bound the stack depth by log n.
+        if (left_size < right_size) {
+            BlockQuicksortLoop(first, pivot_pos, comp, bad_allowed, leftmost);
+            first = pivot_pos + 1;
+            leftmost = false;
+        } else {
+            BlockQuicksortLoop(pivot_pos + 1, last, comp, bad_allowed, false);
+            last = pivot_pos;
+        }
+    }
+}
+
+}  // namespace sort_detail
+
+// Unstable in-place comparison sort: introsort with block (branchless)
+// partitioning, median-of-3 / ninther pivots, equal-key run skipping and a
+// heapsort fallback after log n unbalanced partitions.
+template <class RandomIt, class Compare>
+void BlockQuicksort(RandomIt first, RandomIt last, Compare comp) {
+    std::ptrdiff_t size = last - first;
+    if (size < 2) {
+        return;
+    }
+    int log2 = 0;
+    while ((std::ptrdiff_t{1} << log2) < size) {
+        ++log2;
+    }
+    sort_detail::BlockQuicksortLoop(first, last, comp, log2, true);
+}
+
+template <class RandomIt>
+void BlockQuicksort(RandomIt first, RandomIt last) {
+    BlockQuicksort(first, last, std::less<>());
+}
+
+}  // namespace aisd
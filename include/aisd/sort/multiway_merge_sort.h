@@ -0,0 +1,123 @@
+#pragma once
+
+#include <aisd/parallel.h>
+#include <aisd/sort/block_quicksort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+namespace sort_detail {
+
+// Merges k sorted runs into out with a binary heap of run cursors; k is the
+// thread count, so the heap stays in L1.
+template <class It, class OutIt, class Compare>
+void MultiwayMerge(std::vector<std::pair<It, It>>& runs, OutIt out, Compare comp) {
+    runs.erase(std::remove_if(runs.begin(), runs.end(), [](const auto& run) { return run.first == run.second; }),
+               runs.end());
+    auto greater = [&comp](const std::pair<It, It>& a, const std::pair<It, It>& b) {
+        return comp(*b.first, *a.first);
+    };
+    std::make_heap(runs.begin(), runs.end(), greater);
+    while (runs.size() > 1) {
+        std::pop_heap(runs.begin(), runs.end(), greater);
+        auto& run = runs.back();
+        *out++ = std::move(*run.first++);
+        if (run.first == run.second) {
+            runs.pop_back();
+        } else {
+            std::push_heap(runs.begin(), runs.end(), greater);
+        }
+    }
+    if (!runs.empty()) {
+        std::move(runs[0].first, runs[0].second, out);
+    }
+}
+
+}  // namespace sort_detail
+
+// Parallel multiway mergesort (unstable).
+//
+// 1. The input is cut into one run per thread and each run is sorted by
+//    sort_run(first, last) in parallel.
+// 2. Every run contributes p - 1 regularly spaced samples; p - 1 global
+//    splitters are picked from the sorted samples, and every run is cut at
+//    them with lower_bound. Part k of the output is then the union of the k-th
+//    pieces of all runs, and with regular sampling no part exceeds ~2n/p
+//    unless the keys are heavily duplicated.
+// 3. Each thread merges its part into a scratch buffer with a p-way merge,
+//    then moves it back.
+template <class RandomIt, class Compare, class RunSorter>
+void ParallelMultiwayMergeSort(RandomIt first, RandomIt last, Compare comp, unsigned threads,
+                               RunSorter sort_run) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    std::size_t size = static_cast<std::size_t>(last - first);
+    std::size_t parts = ResolveThreads(threads);
+    if (parts <= 1 || size < parts * 4096) {
+        sort_run(first, last);
+        return;
+    }
+
+    std::vector<std::size_t> run_begin(parts + 1);
+    for (std::size_t i = 0; i <= parts; ++i) {
+        run_begin[i] = size * i / parts;
+    }
+    ParallelFor(parts, static_cast<unsigned>(parts),
+                [&](std::size_t i) { sort_run(first + run_begin[i], first + run_begin[i + 1]); });
+
+    std::vector<T> samples;
+    samples.reserve(parts * (parts - 1));
+    for (std::size_t i = 0; i < parts; ++i) {
+        std::size_t length = run_begin[i + 1] - run_begin[i];
+        for (std::size_t j = 1; j < parts; ++j) {
+            samples.push_back(first[run_begin[i] + length * j / parts]);
+        }
+    }
+    BlockQuicksort(samples.begin(), samples.end(), comp);
+
+    // cuts[i * (parts + 1) + k] is where part k starts inside run i.
+    std::vector<std::size_t> cuts(parts * (parts + 1));
+    ParallelFor(parts, static_cast<unsigned>(parts), [&](std::size_t i) {
+        std::size_t* cut = &cuts[i * (parts + 1)];
+        cut[0] = run_begin[i];
+        cut[parts] = run_begin[i + 1];
+        for (std::size_t k = 1; k < parts; ++k) {
+            const T& splitter = samples[k * samples.size() / parts];
+            cut[k] = static_cast<std::size_t>(
+                std::lower_bound(first + cut[k - 1], first + run_begin[i + 1], splitter, comp) - first);
+        }
+    });
+    std::vector<std::size_t> part_begin(parts + 1, 0);
+    for (std::size_t k = 0; k < parts; ++k) {
+        std::size_t length = 0;
+        for (std::size_t i = 0; i < parts; ++i) {
+            length += cuts[i * (parts + 1) + k + 1] - cuts[i * (parts + 1) + k];
+        }
+        part_begin[k + 1] = part_begin[k] + length;
+    }
+
+    std::vector<T> buffer(size);
+    ParallelFor(parts, static_cast<unsigned>(parts), [&](std::size_t k) {
+        std::vector<std::pair<RandomIt, RandomIt>> pieces;
+        pieces.reserve(parts);
+        for (std::size_t i = 0; i < parts; ++i) {
+            pieces.emplace_back(first + cuts[i * (parts + 1) + k], first + cuts[i * (parts + 1) + k + 1]);
+        }
+        sort_detail::MultiwayMerge(pieces, buffer.begin() + part_begin[k], comp);
+    });
+    ParallelFor(parts, static_cast<unsigned>(parts), [&](std::size_t k) {
+        std::move(buffer.begin() + part_begin[k], buffer.begin() + part_begin[k + 1], first + part_begin[k]);
+    });
+}
+
+template <class RandomIt, class Compare>
+void ParallelMultiwayMergeSort(RandomIt first, RandomIt last, Compare comp, unsigned threads = 0) {
+    ParallelMultiwayMergeSort(first, last, comp, threads,
+                              [&comp](RandomIt a, RandomIt b) { BlockQuicksort(a, b, comp); });
+}
+
+}  // namespace aisd
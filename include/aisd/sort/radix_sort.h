@@ -0,0 +1,171 @@
+#pragma once
+
+#include <aisd/sort/block_quicksort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+namespace sort_detail {
+
+// Maps an integer onto an unsigned one with the same ordering.
+template <class Int>
+auto ToOrderedUnsigned(Int value) {
+    using Unsigned = std::make_unsigned_t<Int>;
+    auto bits = static_cast<Unsigned>(value);
+    if constexpr (std::is_signed_v<Int>) {
+        bits ^= Unsigned{1} << (sizeof(Int) * 8 - 1);
+    }
+    return bits;
+}
+
+struct IdentityKey {
+    template <class T>
+    const T& operator()(const T& value) const {
+        return value;
+    }
+};
+
+// Byte at `depth` shifted by one so that 0 means "string ended here".
+inline unsigned CharAt(std::string_view s, std::size_t depth) {
+    return depth < s.size() ? static_cast<unsigned char>(s[depth]) + 1u : 0u;
+}
+
+inline constexpr std::ptrdiff_t kMsdSmallBucket = 32;
+
+}  // namespace sort_detail
+
+// Stable LSD radix sort of [first, last) by an integer key, 8 bits per pass.
+//
+// All digit histograms are built in a single read pass, and passes in which
+// every key has the same digit are skipped, so e.g. 64-bit keys below 2^20
+// cost three scatters. Needs a scratch buffer of n elements.
+template <class T, class KeyFn>
+void LsdRadixSort(T* first, T* last, KeyFn key) {
+    using Key = std::decay_t<decltype(key(*first))>;
+    static_assert(std::is_integral_v<Key>, "LSD radix sort needs integer keys");
+    constexpr std::size_t kPasses = sizeof(Key);
+    std::size_t size = static_cast<std::size_t>(last - first);
+    if (size < 2) {
+        return;
+    }
+
+    std::vector<std::size_t> counts(kPasses * 256, 0);
+    for (T* it = first; it != last; ++it) {
+        auto bits = sort_detail::ToOrderedUnsigned(key(*it));
+        for (std::size_t pass = 0; pass < kPasses; ++pass) {
+            ++counts[pass * 256 + ((bits >> (pass * 8)) & 0xff)];
+        }
+    }
+
+    std::vector<T> buffer(size);
+    T* source = first;
+    T* target = buffer.data();
+    for (std::size_t pass = 0; pass < kPasses; ++pass) {
+        std::size_t* count = &counts[pass * 256];
+        if (std::find(count, count + 256, size) != count + 256) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit) {
+            std::size_t c = count[digit];
+            count[digit] = offset;
+            offset += c;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            auto bits = sort_detail::ToOrderedUnsigned(key(source[i]));
+            target[count[(bits >> (pass * 8)) & 0xff]++] = std::move(source[i]);
+        }
+        std::swap(source, target);
+    }
+    if (source != first) {
+        std::move(source, source + size, first);
+    }
+}
+
+template <class T>
+void LsdRadixSort(T* first, T* last) {
+    LsdRadixSort(first, last, sort_detail::IdentityKey());
+}
+
+// In-place MSD radix sort (American flag sort) of strings in byte-wise
+// lexicographic order; T is std::string, std::string_view or anything with a
+// conversion to std::string_view.
+//
+// Buckets are permuted in place by cycle leading, so no second copy of the
+// strings is made. Pending ranges live on an explicit stack instead of the
+// call stack, which keeps long common prefixes from exhausting it; small
+// buckets are finished with a comparison sort that skips the known prefix.
+template <class T>
+void MsdRadixSort(T* first, T* last) {
+    struct Range {
+        T* first;
+        T* last;
+        std::size_t depth;
+    };
+    std::vector<Range> stack;
+    stack.push_back({first, last, 0});
+    std::size_t count[257];
+    std::size_t next[257];
+    while (!stack.empty()) {
+        Range range = stack.back();
+        stack.pop_back();
+        std::size_t depth = range.depth;
+        if (range.last - range.first < sort_detail::kMsdSmallBucket) {
+            BlockQuicksort(range.first, range.last, [depth](const T& a, const T& b) {
+                std::string_view sa(a);
+                std::string_view sb(b);
+                return sa.substr(std::min(depth, sa.size())) < sb.substr(std::min(depth, sb.size()));
+            });
+            continue;
+        }
+
+        std::fill(count, count + 257, 0);
+        for (T* it = range.first; it != range.last; ++it) {
+            ++count[sort_detail::CharAt(*it, depth)];
+        }
+        std::size_t offset = 0;
+        for (unsigned c = 0; c < 257; ++c) {
+            next[c] = offset;
+            offset += count[c];
+            count[c] = offset;  // now the end of bucket c
+        }
+        for (unsigned c = 0; c < 257; ++c) {
+            while (next[c] < count[c]) {
+                T* slot = range.first + next[c];
+                unsigned digit = sort_detail::CharAt(*slot, depth);
+                if (digit == c) {
+                    ++next[c];
+                    continue;
+                }
+                // Cycle the element towards its bucket until one fits here.
+                auto value = std::move(*slot);
+                do {
+                    T* dest = range.first + next[digit]++;
+                    std::swap(value, *dest);
+                    digit = sort_detail::CharAt(value, depth);
+                } while (digit != c);
+                *slot = std::move(value);
+                ++next[c];
+            }
+        }
+        // Bucket 0 holds strings that ended at this depth: they are equal.
+        std::size_t begin = count[0];
+        for (unsigned c = 1; c < 257; ++c) {
+            if (count[c] - begin > 1) {
+                stack.push_back({range.first + begin, range.first + count[c], depth + 1});
+            }
+            begin = count[c];
+        }
+    }
+}
+
+}  // namespace aisd
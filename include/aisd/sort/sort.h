@@ -0,0 +1,125 @@
+#pragma once
+
+#include <aisd/parallel.h>
+#include <aisd/sort/block_quicksort.h>
+#include <aisd/sort/multiway_merge_sort.h>
+#include <aisd/sort/radix_sort.h>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace aisd {
+
+enum class SortAlgorithm {
+    kInsertion,
+    kBlockQuicksort,
+    kLsdRadix,
+    kMsdRadix,
+};
+
+namespace sort_detail {
+
+// Below these sizes the extra machinery does not pay off.
+inline constexpr std::size_t kRadixThreshold = 256;
+inline constexpr std::size_t kParallelThreshold = std::size_t{1} << 20;
+
+template <class It>
+inline constexpr bool kIsContiguous =
+    std::is_pointer_v<It> ||
+    std::is_same_v<It, typename std::vector<typename std::iterator_traits<It>::value_type>::iterator> ||
+    std::is_same_v<It, typename std::vector<typename std::iterator_traits<It>::value_type>::const_iterator>;
+
+template <class Compare, class T>
+inline constexpr bool kIsAscending =
+    std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>;
+
+template <class T>
+inline constexpr bool kIsString = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <class It, class Compare>
+SortAlgorithm ChooseAlgorithm(std::size_t size) {
+    using T = typename std::iterator_traits<It>::value_type;
+    if (size < static_cast<std::size_t>(kInsertionSortThreshold)) {
+        return SortAlgorithm::kInsertion;
+    }
+    if constexpr (kIsContiguous<It> && kIsAscending<Compare, T>) {
+        if (size >= kRadixThreshold) {
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                return SortAlgorithm::kLsdRadix;
+            } else if constexpr (kIsString<T>) {
+                return SortAlgorithm::kMsdRadix;
+            }
+        }
+    }
+    return SortAlgorithm::kBlockQuicksort;
+}
+
+template <class It, class Compare>
+void SequentialSort(It first, It last, Compare comp) {
+    using T = typename std::iterator_traits<It>::value_type;
+    switch (ChooseAlgorithm<It, Compare>(static_cast<std::size_t>(last - first))) {
+    case SortAlgorithm::kInsertion:
+        InsertionSort(first, last, comp);
+        return;
+    case SortAlgorithm::kLsdRadix:
+        if constexpr (std::is_integral_v<T> && kIsContiguous<It>) {
+            LsdRadixSort(std::addressof(*first), std::addressof(*first) + (last - first));
+            return;
+        }
+        break;
+    case SortAlgorithm::kMsdRadix:
+        if constexpr (kIsString<T> && kIsContiguous<It>) {
+            MsdRadixSort(std::addressof(*first), std::addressof(*first) + (last - first));
+            return;
+        }
+        break;
+    case SortAlgorithm::kBlockQuicksort:
+        break;
+    }
+    BlockQuicksort(first, last, comp);
+}
+
+}  // namespace sort_detail
+
+// Sequential algorithm Sort() uses for n elements of [first, last) before
+// parallel splitting; exposed for benchmarks and tests.
+template <class RandomIt, class Compare = std::less<>>
+SortAlgorithm ChooseSortAlgorithm(std::size_t size) {
+    return sort_detail::ChooseAlgorithm<RandomIt, Compare>(size);
+}
+
+// Sorts [first, last) (unstable), picking the algorithm by key type and size:
+//   - integers in ascending order: LSD radix sort;
+//   - std::string / std::string_view in ascending order: MSD radix sort;
+//   - anything else: block quicksort;
+//   - below a few dozen elements: insertion sort.
+// Inputs of 2^20+ elements are sorted with the parallel multiway mergesort
+// using the choice above for each per-thread run. threads == 0 means all
+// hardware threads; threads == 1 keeps everything on the calling thread.
+template <class RandomIt, class Compare>
+void Sort(RandomIt first, RandomIt last, Compare comp, unsigned threads = 0) {
+    std::size_t size = static_cast<std::size_t>(last - first);
+    if (size < 2) {
+        return;
+    }
+    threads = ResolveThreads(threads);
+    if (threads > 1 && size >= sort_detail::kParallelThreshold) {
+        ParallelMultiwayMergeSort(first, last, comp, threads,
+                                  [&comp](RandomIt a, RandomIt b) { sort_detail::SequentialSort(a, b, comp); });
+        return;
+    }
+    sort_detail::SequentialSort(first, last, comp);
+}
+
+template <class RandomIt>
+void Sort(RandomIt first, RandomIt last) {
+    Sort(first, last, std::less<>());
+}
+
+}  // namespace aisd
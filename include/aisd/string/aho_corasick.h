@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// Aho-Corasick multi-pattern matcher stored as a double-array trie.
+//
+// Patterns are first collected in a pointer-free builder trie; Build() lays
+// the states out so that the child of state s by byte c is state base[s] + c,
+// verified by check[base[s] + c] == s. A transition is thus two array reads,
+// and a state costs five 32-bit words however many children it has (versus
+// 256 for a full DFA row). Missing transitions fall back through failure
+// links. Matching is streaming: a Cursor carries the automaton state across
+// chunks, so a memory-mapped log can be fed piece by piece.
+class AhoCorasick {
+public:
+    using State = std::int32_t;
+
+    // Adds a pattern and returns its id (ids are consecutive from 0). Empty
+    // patterns are ignored and get no matches.
+    std::size_t AddPattern(std::string_view pattern) {
+        assert(!built_);
+        if (trie_.empty()) {
+            trie_.emplace_back();
+        }
+        std::size_t node = 0;
+        for (char ch : pattern) {
+            auto byte = static_cast<unsigned char>(ch);
+            std::size_t next = FindChild(node, byte);
+            if (next == kNone) {
+                next = trie_.size();
+                trie_[node].children.emplace_back(byte, next);
+                trie_.emplace_back();
+            }
+            node = next;
+        }
+        std::size_t id = pattern_lengths_.size();
+        pattern_lengths_.push_back(pattern.size());
+        if (!pattern.empty()) {
+            trie_[node].patterns.push_back(id);
+        }
+        return id;
+    }
+
+    void Build();
+
+    std::size_t PatternCount() const {
+        return pattern_lengths_.size();
+    }
+
+    std::size_t PatternLength(std::size_t id) const {
+        return pattern_lengths_[id];
+    }
+
+    // Double-array slots, i.e. the memory footprint in units of 5 words.
+    std::size_t Slots() const {
+        return check_.size();
+    }
+
+    class Cursor {
+    public:
+        explicit Cursor(const AhoCorasick& automaton) : automaton_(&automaton) {
+        }
+
+        // Feeds the next chunk; calls on_match(pattern_id, end) for every
+        // occurrence, where end is the offset just past the match counted
+        // from the start of the whole stream.
+        template <class Fn>
+        void Feed(std::string_view chunk, Fn&& on_match) {
+            const AhoCorasick& ac = *automaton_;
+            for (char ch : chunk) {
+                state_ = ac.Next(state_, static_cast<unsigned char>(ch));
+                ++offset_;
+                for (State s = ac.output_[state_] >= 0 ? state_ : ac.dict_link_[state_]; s >= 0;
+                     s = ac.dict_link_[s]) {
+                    for (std::int32_t p = ac.output_[s]; p >= 0; p = ac.next_pattern_[p]) {
+                        on_match(static_cast<std::size_t>(p), offset_);
+                    }
+                }
+            }
+        }
+
+        std::size_t Offset() const {
+            return offset_;
+        }
+
+    private:
+        const AhoCorasick* automaton_;
+        State state_ = 0;
+        std::size_t offset_ = 0;
+    };
+
+    template <class Fn>
+    void Scan(std::string_view text, Fn&& on_match) const {
+        Cursor cursor(*this);
+        cursor.Feed(text, std::forward<Fn>(on_match));
+    }
+
+private:
+    static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+    struct TrieNode {
+        std::vector<std::pair<unsigned char, std::size_t>> children;
+        std::vector<std::size_t> patterns;
+    };
+
+    std::size_t FindChild(std::size_t node, unsigned char byte) const {
+        for (const auto& [label, child] : trie_[node].children) {
+            if (label == byte) {
+                return child;
+            }
+        }
+        return kNone;
+    }
+
+    State Child(State state, unsigned char byte) const {
+        std::size_t slot = static_cast<std::size_t>(base_[state]) + byte;
+        return slot < check_.size() && check_[slot] == state ? static_cast<State>(slot) : -1;
+    }
+
+    State Next(State state, unsigned char byte) const {
+        while (true) {
+            State child = Child(state, byte);
+            if (child >= 0) {
+                return child;
+            }
+            if (state == 0) {
+                return 0;
+            }
+            state = fail_[state];
+        }
+    }
+
+    // Lowest base such that base + label is free for every child label.
+    std::size_t FindBase(const std::vector<std::pair<unsigned char, std::size_t>>& children);
+
+    void SetOutputs(State state, const std::vector<std::size_t>& patterns) {
+        std::int32_t last = -1;
+        for (std::size_t id : patterns) {
+            if (last < 0) {
+                output_[state] = static_cast<std::int32_t>(id);
+            } else {
+                next_pattern_[last] = static_cast<std::int32_t>(id);
+            }
+            last = static_cast<std::int32_t>(id);
+        }
+    }
+
+    void EnsureSlots(std::size_t size) {
+        if (size > check_.size()) {
+            check_.resize(size, -1);
+            base_.resize(size, 0);
+            fail_.resize(size, 0);
+            output_.resize(size, -1);
+            dict_link_.resize(size, -1);
+        }
+    }
+
+    bool built_ = false;
+    std::vector<TrieNode> trie_;
+    std::vector<std::size_t> pattern_lengths_;
+
+    std::vector<State> base_;
+    std::vector<State> check_;  // parent state, -1 for a free slot
+    std::vector<State> fail_;
+    std::vector<std::int32_t> output_;     // first pattern ending here, -1 if none
+    std::vector<State> dict_link_;         // nearest proper suffix state with output
+    std::vector<std::int32_t> next_pattern_;  // further patterns equal to this one
+    std::size_t first_free_ = 1;
+};
+
+inline std::size_t AhoCorasick::FindBase(const std::vector<std::pair<unsigned char, std::size_t>>& children) {
+    unsigned char first_label = children.front().first;
+    for (std::size_t slot = first_free_;; ++slot) {
+        if (slot < check_.size() && check_[slot] != -1) {
+            continue;
+        }
+        if (slot < first_label) {
+            continue;
+        }
+        std::size_t base = slot - first_label;
+        bool fits = true;
+        for (const auto& child : children) {
+            std::size_t target = base + child.first;
+            if (target == 0 || (target < check_.size() && check_[target] != -1)) {
+                fits = false;
+                break;
+            }
+        }
+        if (fits) {
+            return base;
+        }
+    }
+}
+
+// Places states breadth first, so that failure links (which always point to
+// shallower states) can be computed in the same pass.
+inline void AhoCorasick::Build() {
+    assert(!built_);
+    built_ = true;
+    if (trie_.empty()) {
+        trie_.emplace_back();
+    }
+    next_pattern_.assign(pattern_lengths_.size(), -1);
+    EnsureSlots(1);
+    check_[0] = 0;
+
+    std::vector<std::pair<std::size_t, State>> queue;  // (trie node, state)
+    queue.emplace_back(0, 0);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        auto [node, state] = queue[head];
+        auto& trie_node = trie_[node];
+        if (trie_node.children.empty()) {
+            continue;
+        }
+        std::sort(trie_node.children.begin(), trie_node.children.end());
+
+        std::size_t base = FindBase(trie_node.children);
+        EnsureSlots(base + trie_node.children.back().first + 1);
+        for (const auto& child : trie_node.children) {
+            check_[base + child.first] = state;
+        }
+        while (first_free_ < check_.size() && check_[first_free_] != -1) {
+            ++first_free_;
+        }
+        base_[state] = static_cast<State>(base);
+
+        for (const auto& [label, child_node] : trie_node.children) {
+            auto child = static_cast<State>(base + label);
+            State fail = 0;
+            if (state != 0) {
+                fail = Next(fail_[state], label);
+            }
+            fail_[child] = fail;
+            // Outputs are set on creation: fail may sit on this level too.
+            SetOutputs(child, trie_[child_node].patterns);
+            dict_link_[child] = output_[fail] >= 0 ? fail : dict_link_[fail];
+            queue.emplace_back(child_node, child);
+        }
+    }
+    trie_.clear();
+    trie_.shrink_to_fit();
+}
+
+}  // namespace aisd
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aisd {
+
+// RAII wrapper over a memory-mapped file (POSIX). Read-only mappings back the
+// string algorithms' input, writable ones let suffix and LCP arrays of inputs
+// bigger than RAM live in the page cache instead of anonymous memory. Failures
+// throw std::system_error.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    static MappedFile OpenReadOnly(const std::string& path) {
+        MappedFile file;
+        file.fd_ = ::open(path.c_str(), O_RDONLY);
+        if (file.fd_ < 0) {
+            Fail("open " + path);
+        }
+        struct stat st {};
+        if (::fstat(file.fd_, &st) != 0) {
+            Fail("stat " + path);
+        }
+        file.Map(static_cast<std::size_t>(st.st_size), PROT_READ, path);
+        return file;
+    }
+
+    // Creates (or truncates) the file and sizes it to `size` bytes.
+    static MappedFile CreateReadWrite(const std::string& path, std::size_t size) {
+        MappedFile file;
+        file.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file.fd_ < 0) {
+            Fail("open " + path);
+        }
+        if (::ftruncate(file.fd_, static_cast<off_t>(size)) != 0) {
+            Fail("truncate " + path);
+        }
+        file.Map(size, PROT_READ | PROT_WRITE, path);
+        return file;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept {
+        Swap(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        Close();
+    }
+
+    const char* Data() const {
+        return data_;
+    }
+
+    char* MutableData() {
+        return data_;
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    std::string_view View() const {
+        return {data_, size_};
+    }
+
+    // Kernel read-ahead hint for a front-to-back pass.
+    void AdviseSequential() const {
+        if (size_ != 0) {
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+    // Drops the clean pages of [offset, offset + length) from this mapping;
+    // they are re-read from the file if touched again. Keeps the resident set
+    // of a one-pass scan bounded by the chunk size.
+    void Release(std::size_t offset, std::size_t length) const {
+        std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t begin = offset / page * page;
+        std::size_t end = std::min(offset + length, size_) / page * page;
+        if (begin < end) {
+            ::madvise(data_ + begin, end - begin, MADV_DONTNEED);
+        }
+    }
+
+    // Calls fn(chunk, offset) over consecutive chunks of the file and releases
+    // each chunk once fn returns.
+    template <class Fn>
+    void ForEachChunk(std::size_t chunk_size, Fn&& fn) const {
+        AdviseSequential();
+        for (std::size_t offset = 0; offset < size_; offset += chunk_size) {
+            std::size_t length = std::min(chunk_size, size_ - offset);
+            fn(std::string_view(data_ + offset, length), offset);
+            Release(offset, length);
+        }
+    }
+
+private:
+    [[noreturn]] static void Fail(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void Map(std::size_t size, int protection, const std::string& path) {
+        size_ = size;
+        if (size == 0) {
+            return;
+        }
+        void* data = ::mmap(nullptr, size, protection, MAP_SHARED, fd_, 0);
+        if (data == MAP_FAILED) {
+            Fail("mmap " + path);
+        }
+        data_ = static_cast<char*>(data);
+    }
+
+    void Close() {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+        fd_ = -1;
+    }
+
+    void Swap(MappedFile& other) {
+        std::swap(fd_, other.fd_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    int fd_ = -1;
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}  // namespace aisd
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+// z[i] is the length of the longest common prefix of s and s[i..]; z[0] = |s|.
+inline std::vector<std::size_t> ZFunction(std::string_view s) {
+    std::size_t n = s.size();
+    std::vector<std::size_t> z(n, 0);
+    if (n == 0) {
+        return z;
+    }
+    z[0] = n;
+    for (std::size_t i = 1, left = 0, right = 0; i < n; ++i) {
+        if (i < right) {
+            z[i] = std::min(right - i, z[i - left]);
+        }
+        while (i + z[i] < n && s[z[i]] == s[i + z[i]]) {
+            ++z[i];
+        }
+        if (i + z[i] > right) {
+            left = i;
+            right = i + z[i];
+        }
+    }
+    return z;
+}
+
+// pi[i] is the length of the longest proper border of s[0..i].
+inline std::vector<std::size_t> PrefixFunction(std::string_view s) {
+    std::vector<std::size_t> pi(s.size(), 0);
+    for (std::size_t i = 1; i < s.size(); ++i) {
+        std::size_t k = pi[i - 1];
+        while (k > 0 && s[i] != s[k]) {
+            k = pi[k - 1];
+        }
+        if (s[i] == s[k]) {
+            ++k;
+        }
+        pi[i] = k;
+    }
+    return pi;
+}
+
+// Knuth-Morris-Pratt matcher for one pattern over a stream of chunks. Only
+// the pattern and its prefix function are stored, so matches that straddle
+// chunk boundaries are found without buffering any text.
+class KmpMatcher {
+public:
+    explicit KmpMatcher(std::string pattern) : pattern_(std::move(pattern)), pi_(PrefixFunction(pattern_)) {
+    }
+
+    // Calls on_match(end) for every occurrence, end being the stream offset
+    // just past it. An empty pattern matches nothing.
+    template <class Fn>
+    void Feed(std::string_view chunk, Fn&& on_match) {
+        if (pattern_.empty()) {
+            offset_ += chunk.size();
+            return;
+        }
+        for (char ch : chunk) {
+            ++offset_;
+            while (matched_ > 0 && ch != pattern_[matched_]) {
+                matched_ = pi_[matched_ - 1];
+            }
+            if (ch == pattern_[matched_]) {
+                ++matched_;
+            }
+            if (matched_ == pattern_.size()) {
+                on_match(offset_);
+                matched_ = pi_[matched_ - 1];
+            }
+        }
+    }
+
+    void Reset() {
+        matched_ = 0;
+        offset_ = 0;
+    }
+
+private:
+    std::string pattern_;
+    std::vector<std::size_t> pi_;
+    std::size_t matched_ = 0;
+    std::size_t offset_ = 0;
+};
+
+// Start positions of all (possibly overlapping) occurrences of pattern.
+inline std::vector<std::size_t> FindAll(std::string_view text, std::string_view pattern) {
+    std::vector<std::size_t> positions;
+    if (pattern.empty() || pattern.size() > text.size()) {
+        return positions;
+    }
+    KmpMatcher matcher{std::string(pattern)};
+    matcher.Feed(text, [&](std::size_t end) { positions.push_back(end - pattern.size()); });
+    return positions;
+}
+
+}  // namespace aisd
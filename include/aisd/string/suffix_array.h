@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace aisd {
+
+namespace string_detail {
+
+// One bit per position: 1 for S-type, 0 for L-type suffixes.
+class TypeBits {
+public:
+    explicit TypeBits(std::size_t size) : bits_((size + 63) / 64, 0) {
+    }
+
+    bool Get(std::size_t i) const {
+        return (bits_[i / 64] >> (i % 64)) & 1;
+    }
+
+    void Set(std::size_t i, bool value) {
+        std::uint64_t mask = std::uint64_t{1} << (i % 64);
+        bits_[i / 64] = value ? bits_[i / 64] | mask : bits_[i / 64] & ~mask;
+    }
+
+private:
+    std::vector<std::uint64_t> bits_;
+};
+
+// Level 0 view of the text: bytes shifted up by one, followed by a virtual
+// sentinel 0 at position n, so the mapped input never has to be copied.
+struct ByteText {
+    const unsigned char* data;
+    std::size_t size;
+
+    std::size_t operator[](std::size_t i) const {
+        return i < size ? static_cast<std::size_t>(data[i]) + 1 : 0;
+    }
+};
+
+// Deeper levels: names of LMS substrings stored inside the SA buffer; the
+// last one is the sentinel's unique name 0.
+template <class Index>
+struct NameText {
+    const Index* data;
+
+    std::size_t operator[](std::size_t i) const {
+        return static_cast<std::size_t>(data[i]);
+    }
+};
+
+template <class Index, class Text>
+class SaIs {
+public:
+    // text has `size` symbols in [0, alphabet), the last of which is a unique
+    // smallest sentinel.
+    SaIs(Text text, std::size_t size, std::size_t alphabet, Index* sa)
+        : text_(text), size_(size), alphabet_(alphabet), sa_(sa), types_(size) {
+    }
+
+    void Run();
+
+private:
+    static constexpr Index kEmpty = -1;
+
+    bool IsLms(std::size_t i) const {
+        return i > 0 && types_.Get(i) && !types_.Get(i - 1);
+    }
+
+    void Buckets(std::vector<Index>& bucket, bool end) const {
+        bucket.assign(alphabet_, 0);
+        for (std::size_t i = 0; i < size_; ++i) {
+            ++bucket[text_[i]];
+        }
+        Index sum = 0;
+        for (std::size_t c = 0; c < alphabet_; ++c) {
+            sum += bucket[c];
+            bucket[c] = end ? sum : sum - bucket[c];
+        }
+    }
+
+    void InduceL(std::vector<Index>& bucket) {
+        Buckets(bucket, false);
+        for (std::size_t i = 0; i < size_; ++i) {
+            Index j = sa_[i] - 1;
+            if (sa_[i] > 0 && !types_.Get(static_cast<std::size_t>(j))) {
+                sa_[bucket[text_[static_cast<std::size_t>(j)]]++] = j;
+            }
+        }
+    }
+
+    void InduceS(std::vector<Index>& bucket) {
+        Buckets(bucket, true);
+        for (std::size_t i = size_; i-- > 0;) {
+            Index j = sa_[i] - 1;
+            if (sa_[i] > 0 && types_.Get(static_cast<std::size_t>(j))) {
+                sa_[--bucket[text_[static_cast<std::size_t>(j)]]] = j;
+            }
+        }
+    }
+
+    bool SameLmsSubstring(std::size_t a, std::size_t b) const {
+        for (std::size_t d = 0;; ++d) {
+            if (text_[a + d] != text_[b + d] || types_.Get(a + d) != types_.Get(b + d)) {
+                return false;
+            }
+            if (d > 0 && (IsLms(a + d) || IsLms(b + d))) {
+                return IsLms(a + d) && IsLms(b + d);
+            }
+        }
+    }
+
+    Text text_;
+    std::size_t size_;
+    std::size_t alphabet_;
+    Index* sa_;
+    TypeBits types_;
+};
+
+// SA-IS (Nong, Zhang and Chan, 2009): sort LMS substrings by induced sorting,
+// name them, recurse on the names if they are not unique, then induce the
+// full order from the sorted LMS suffixes. The reduced string and its suffix
+// array are kept inside the output buffer. Heap memory on top of that is the
+// type bits of every level still on the stack (under 2n bits in total) and
+// one bucket array: 257 entries at level 0, but at level 1 the alphabet is
+// the number of LMS names, up to n / 2 entries. A level frees its buckets
+// before recursing, so only one bucket array is live at a time.
+template <class Index, class Text>
+void SaIs<Index, Text>::Run() {
+    std::size_t n = size_;
+    if (n == 1) {
+        sa_[0] = 0;
+        return;
+    }
+    types_.Set(n - 1, true);
+    types_.Set(n - 2, false);
+    for (std::size_t i = n - 2; i-- > 0;) {
+        types_.Set(i, text_[i] < text_[i + 1] || (text_[i] == text_[i + 1] && types_.Get(i + 1)));
+    }
+
+    // Stage 1: sort LMS substrings.
+    std::vector<Index> bucket;
+    Buckets(bucket, true);
+    for (std::size_t i = 0; i < n; ++i) {
+        sa_[i] = kEmpty;
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        if (IsLms(i)) {
+            sa_[--bucket[text_[i]]] = static_cast<Index>(i);
+        }
+    }
+    InduceL(bucket);
+    InduceS(bucket);
+
+    std::size_t lms_count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (sa_[i] >= 0 && IsLms(static_cast<std::size_t>(sa_[i]))) {
+            sa_[lms_count++] = sa_[i];
+        }
+    }
+
+    // Name the sorted LMS substrings; LMS positions are at least two apart,
+    // so position / 2 indexes the upper half without collisions.
+    for (std::size_t i = lms_count; i < n; ++i) {
+        sa_[i] = kEmpty;
+    }
+    Index name = 0;
+    std::size_t previous = n;
+    for (std::size_t i = 0; i < lms_count; ++i) {
+        std::size_t position = static_cast<std::size_t>(sa_[i]);
+        if (previous == n || !SameLmsSubstring(position, previous)) {
+            ++name;
+            previous = position;
+        }
+        sa_[lms_count + position / 2] = name - 1;
+    }
+    for (std::size_t i = n, j = n; i-- > lms_count;) {
+        if (sa_[i] >= 0) {
+            sa_[--j] = sa_[i];
+        }
+    }
+
+    // Stage 2: suffix array of the reduced string, in sa_[0, lms_count).
+    Index* reduced = sa_ + (n - lms_count);
+    if (static_cast<std::size_t>(name) < lms_count) {
+        std::vector<Index>().swap(bucket);
+        SaIs<Index, NameText<Index>>(NameText<Index>{reduced}, lms_count, static_cast<std::size_t>(name), sa_)
+            .Run();
+    } else {
+        for (std::size_t i = 0; i < lms_count; ++i) {
+            sa_[reduced[i]] = static_cast<Index>(i);
+        }
+    }
+
+    // Stage 3: place LMS suffixes in sorted order at their bucket ends and
+    // induce the rest.
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        if (IsLms(i)) {
+            reduced[j++] = static_cast<Index>(i);
+        }
+    }
+    for (std::size_t i = 0; i < lms_count; ++i) {
+        sa_[i] = reduced[sa_[i]];
+    }
+    for (std::size_t i = lms_count; i < n; ++i) {
+        sa_[i] = kEmpty;
+    }
+    Buckets(bucket, true);
+    for (std::size_t i = lms_count; i-- > 0;) {
+        Index j = sa_[i];
+        sa_[i] = kEmpty;
+        sa_[--bucket[text_[static_cast<std::size_t>(j)]]] = j;
+    }
+    InduceL(bucket);
+    InduceS(bucket);
+}
+
+}  // namespace string_detail
+
+// Builds the suffix array of text in linear time with SA-IS.
+//
+// sa must have room for text.size() + 1 entries: on return sa[0] is
+// text.size() (the empty suffix) and sa[1 .. n] are the suffixes in
+// lexicographic (byte) order. Index is a signed integer wide enough for n + 1:
+// int32_t up to 2^31 - 2 bytes, int64_t beyond. Neither text nor sa is
+// copied, so both may be memory-mapped files (see MappedFile). The heap
+// still holds up to n / 2 + 257 Index bucket counters and 2n type bits (see
+// SaIs::Run).
+template <class Index>
+void BuildSuffixArray(std::string_view text, Index* sa) {
+    static_assert(std::is_signed_v<Index>, "SA-IS marks empty slots with -1");
+    string_detail::ByteText bytes{reinterpret_cast<const unsigned char*>(text.data()), text.size()};
+    string_detail::SaIs<Index, string_detail::ByteText>(bytes, text.size() + 1, 257, sa).Run();
+}
+
+template <class Index = std::int32_t>
+std::vector<Index> SuffixArray(std::string_view text) {
+    std::vector<Index> sa(text.size() + 1);
+    BuildSuffixArray(text, sa.data());
+    sa.erase(sa.begin());
+    return sa;
+}
+
+// LCP array for a suffix array sa of n entries (without the empty suffix):
+// lcp[0] = 0 and lcp[i] is the longest common prefix of suffixes sa[i - 1]
+// and sa[i]. Uses the Phi algorithm (Kaerkkaeinen, Manzini and Puglisi,
+// 2009): the text is walked in order, so a mapped input is read sequentially
+// except for one jump per suffix.
+//
+// phi is scratch space for n entries. Like sa and lcp it may be a writable
+// MappedFile, so nothing proportional to n is allocated; for a buffer filled
+// by BuildSuffixArray pass sa + 1.
+template <class Index>
+void BuildLcpArray(std::string_view text, const Index* sa, Index* lcp, Index* phi) {
+    std::size_t n = text.size();
+    if (n == 0) {
+        return;
+    }
+    phi[static_cast<std::size_t>(sa[0])] = -1;
+    for (std::size_t i = 1; i < n; ++i) {
+        phi[static_cast<std::size_t>(sa[i])] = sa[i - 1];
+    }
+    // Turn phi into the permuted LCP array in place: PLCP[i + 1] >= PLCP[i] - 1.
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (phi[i] < 0) {
+            phi[i] = 0;
+            length = 0;
+            continue;
+        }
+        std::size_t j = static_cast<std::size_t>(phi[i]);
+        while (i + length < n && j + length < n && text[i + length] == text[j + length]) {
+            ++length;
+        }
+        phi[i] = static_cast<Index>(length);
+        if (length > 0) {
+            --length;
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        lcp[i] = phi[static_cast<std::size_t>(sa[i])];
+    }
+}
+
+template <class Index>
+std::vector<Index> LcpArray(std::string_view text, const std::vector<Index>& sa) {
+    std::vector<Index> lcp(sa.size());
+    std::vector<Index> phi(sa.size());
+    BuildLcpArray(text, sa.data(), lcp.data(), phi.data());
+    return lcp;
+}
+
+}  // namespace aisd
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace aisd {
+
+// Ordered set as a B-tree of minimum degree kMinDegree (every node but the
+// root holds kMinDegree - 1 .. 2 * kMinDegree - 1 keys) augmented with subtree
+// sizes for Rank/Select.
+//
+// With the default degree a node holds up to 31 keys, so a lookup in 10^7 keys
+// touches 5 nodes instead of ~23 for a red-black tree, and inside a node keys
+// are counted with a branchless linear scan. Insert splits full nodes and
+// Erase refills minimal nodes on the way down (CLRS, ch. 18), so every update
+// is a single root-to-leaf pass. Keys must be default constructible.
+template <class Key, std::size_t kMinDegree = 16, class Compare = std::less<Key>>
+class BTreeSet {
+    static_assert(kMinDegree >= 2, "minimum degree must be at least 2");
+
+public:
+    explicit BTreeSet(Compare compare = Compare()) : compare_(std::move(compare)) {
+    }
+
+    BTreeSet(const BTreeSet&) = delete;
+    BTreeSet& operator=(const BTreeSet&) = delete;
+
+    BTreeSet(BTreeSet&& other) noexcept : compare_(std::move(other.compare_)), root_(other.root_) {
+        other.root_ = nullptr;
+    }
+
+    BTreeSet& operator=(BTreeSet&& other) noexcept {
+        if (this != &other) {
+            Destroy(root_);
+            compare_ = std::move(other.compare_);
+            root_ = other.root_;
+            other.root_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~BTreeSet() {
+        Destroy(root_);
+    }
+
+    std::size_t Size() const {
+        return root_ == nullptr ? 0 : root_->size;
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    void Clear() {
+        Destroy(root_);
+        root_ = nullptr;
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != nullptr;
+    }
+
+    // Returns false if the key was already present.
+    bool Insert(const Key& key) {
+        if (root_ == nullptr) {
+            root_ = new Node();
+        } else if (Contains(key)) {
+            return false;
+        }
+        if (root_->count == kMaxKeys) {
+            Node* root = new Node();
+            root->leaf = false;
+            root->size = root_->size;
+            root->children[0] = root_;
+            root_ = root;
+            SplitChild(root, 0);
+        }
+        InsertNonFull(root_, key);
+        return true;
+    }
+
+    // Returns false if the key was not present.
+    bool Erase(const Key& key) {
+        if (!Contains(key)) {
+            return false;
+        }
+        Erase(root_, key);
+        if (root_->count == 0) {
+            Node* old = root_;
+            root_ = root_->leaf ? nullptr : root_->children[0];
+            delete old;
+        }
+        return true;
+    }
+
+    // Number of keys < key.
+    std::size_t Rank(const Key& key) const {
+        std::size_t rank = 0;
+        for (const Node* node = root_; node != nullptr;) {
+            std::size_t i = LowerIndex(node, key);
+            rank += i;
+            if (node->leaf) {
+                break;
+            }
+            for (std::size_t j = 0; j < i; ++j) {
+                rank += node->children[j]->size;
+            }
+            if (i < node->count && !compare_(key, node->keys[i])) {
+                rank += node->children[i]->size;
+                break;
+            }
+            node = node->children[i];
+        }
+        return rank;
+    }
+
+    // The rank-th smallest key, 0-based.
+    const Key& Select(std::size_t rank) const {
+        assert(rank < Size());
+        const Node* node = root_;
+        while (!node->leaf) {
+            std::size_t i = 0;
+            for (; i < node->count; ++i) {
+                std::size_t left = node->children[i]->size;
+                if (rank < left) {
+                    break;
+                }
+                if (rank == left) {
+                    return node->keys[i];
+                }
+                rank -= left + 1;
+            }
+            node = node->children[i];
+        }
+        return node->keys[rank];
+    }
+
+    // Smallest key >= key, or nullptr.
+    const Key* LowerBound(const Key& key) const {
+        const Key* best = nullptr;
+        for (const Node* node = root_; node != nullptr;) {
+            std::size_t i = LowerIndex(node, key);
+            if (i < node->count) {
+                best = &node->keys[i];
+                if (!compare_(key, node->keys[i])) {
+                    break;
+                }
+            }
+            node = node->leaf ? nullptr : node->children[i];
+        }
+        return best;
+    }
+
+    // Number of keys in [low, high).
+    std::size_t CountRange(const Key& low, const Key& high) const {
+        std::size_t end = Rank(high);
+        std::size_t begin = Rank(low);
+        return end > begin ? end - begin : 0;
+    }
+
+private:
+    static constexpr std::size_t kMaxKeys = 2 * kMinDegree - 1;
+
+    struct Node {
+        std::uint32_t count = 0;
+        bool leaf = true;
+        std::size_t size = 0;  // keys in this subtree
+        Key keys[kMaxKeys];
+        Node* children[kMaxKeys + 1];
+    };
+
+    static void Destroy(Node* node) {
+        if (node == nullptr) {
+            return;
+        }
+        if (!node->leaf) {
+            for (std::size_t i = 0; i <= node->count; ++i) {
+                Destroy(node->children[i]);
+            }
+        }
+        delete node;
+    }
+
+    // Number of keys in the node that are < key. No early exit: the loop has
+    // a fixed trip count and compiles to compare-and-add.
+    std::size_t LowerIndex(const Node* node, const Key& key) const {
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < node->count; ++i) {
+            index += compare_(node->keys[i], key);
+        }
+        return index;
+    }
+
+    const Key* Find(const Key& key) const {
+        for (const Node* node = root_; node != nullptr;) {
+            std::size_t i = LowerIndex(node, key);
+            if (i < node->count && !compare_(key, node->keys[i])) {
+                return &node->keys[i];
+            }
+            node = node->leaf ? nullptr : node->children[i];
+        }
+        return nullptr;
+    }
+
+    // Splits the full child i of parent around its median key.
+    void SplitChild(Node* parent, std::size_t i) {
+        Node* left = parent->children[i];
+        Node* right = new Node();
+        right->leaf = left->leaf;
+        right->count = kMinDegree - 1;
+        right->size = kMinDegree - 1;
+        for (std::size_t j = 0; j < kMinDegree - 1; ++j) {
+            right->keys[j] = std::move(left->keys[kMinDegree + j]);
+        }
+        if (!left->leaf) {
+            for (std::size_t j = 0; j < kMinDegree; ++j) {
+                right->children[j] = left->children[kMinDegree + j];
+                right->size += right->children[j]->size;
+            }
+        }
+        left->count = kMinDegree - 1;
+        left->size -= right->size + 1;
+
+        for (std::size_t j = parent->count; j > i; --j) {
+            parent->keys[j] = std::move(parent->keys[j - 1]);
+            parent->children[j + 1] = parent->children[j];
+        }
+        parent->keys[i] = std::move(left->keys[kMinDegree - 1]);
+        parent->children[i + 1] = right;
+        ++parent->count;
+    }
+
+    void InsertNonFull(Node* node, const Key& key) {
+        while (true) {
+            ++node->size;
+            std::size_t i = LowerIndex(node, key);
+            if (node->leaf) {
+                for (std::size_t j = node->count; j > i; --j) {
+                    node->keys[j] = std::move(node->keys[j - 1]);
+                }
+                node->keys[i] = key;
+                ++node->count;
+                return;
+            }
+            if (node->children[i]->count == kMaxKeys) {
+                SplitChild(node, i);
+                if (compare_(node->keys[i], key)) {
+                    ++i;
+                }
+            }
+            node = node->children[i];
+        }
+    }
+
+    // Removes key i (and child i + 1 if internal) from the node.
+    static void RemoveFromNode(Node* node, std::size_t i) {
+        for (std::size_t j = i; j + 1 < node->count; ++j) {
+            node->keys[j] = std::move(node->keys[j + 1]);
+        }
+        if (!node->leaf) {
+            for (std::size_t j = i + 1; j < node->count; ++j) {
+                node->children[j] = node->children[j + 1];
+            }
+        }
+        --node->count;
+    }
+
+    // Folds key i and child i + 1 of parent into child i; both children hold
+    // kMinDegree - 1 keys.
+    static void Merge(Node* parent, std::size_t i) {
+        Node* left = parent->children[i];
+        Node* right = parent->children[i + 1];
+        left->keys[left->count] = std::move(parent->keys[i]);
+        for (std::size_t j = 0; j < right->count; ++j) {
+            left->keys[left->count + 1 + j] = std::move(right->keys[j]);
+        }
+        if (!left->leaf) {
+            for (std::size_t j = 0; j <= right->count; ++j) {
+                left->children[left->count + 1 + j] = right->children[j];
+            }
+        }
+        left->count += right->count + 1;
+        left->size += right->size + 1;
+        RemoveFromNode(parent, i);
+        delete right;
+    }
+
+    // Moves one key from child i - 1 through the parent into child i.
+    static void RotateRight(Node* parent, std::size_t i) {
+        Node* child = parent->children[i];
+        Node* sibling = parent->children[i - 1];
+        for (std::size_t j = child->count; j > 0; --j) {
+            child->keys[j] = std::move(child->keys[j - 1]);
+        }
+        child->keys[0] = std::move(parent->keys[i - 1]);
+        parent->keys[i - 1] = std::move(sibling->keys[sibling->count - 1]);
+        std::size_t moved = 1;
+        if (!child->leaf) {
+            for (std::size_t j = child->count + 1; j > 0; --j) {
+                child->children[j] = child->children[j - 1];
+            }
+            child->children[0] = sibling->children[sibling->count];
+            moved += child->children[0]->size;
+        }
+        ++child->count;
+        --sibling->count;
+        child->size += moved;
+        sibling->size -= moved;
+    }
+
+    // Moves one key from child i + 1 through the parent into child i.
+    static void RotateLeft(Node* parent, std::size_t i) {
+        Node* child = parent->children[i];
+        Node* sibling = parent->children[i + 1];
+        child->keys[child->count] = std::move(parent->keys[i]);
+        parent->keys[i] = std::move(sibling->keys[0]);
+        std::size_t moved = 1;
+        if (!child->leaf) {
+            child->children[child->count + 1] = sibling->children[0];
+            moved += sibling->children[0]->size;
+            for (std::size_t j = 0; j < sibling->count; ++j) {
+                sibling->children[j] = sibling->children[j + 1];
+            }
+        }
+        for (std::size_t j = 0; j + 1 < sibling->count; ++j) {
+            sibling->keys[j] = std::move(sibling->keys[j + 1]);
+        }
+        ++child->count;
+        --sibling->count;
+        child->size += moved;
+        sibling->size -= moved;
+    }
+
+    // Removes a key known to be in the subtree of node. Every node entered
+    // below the root has at least kMinDegree keys, so removal never underflows.
+    void Erase(Node* node, Key key) {
+        while (true) {
+            --node->size;
+            std::size_t i = LowerIndex(node, key);
+            bool found = i < node->count && !compare_(key, node->keys[i]);
+            if (node->leaf) {
+                assert(found);
+                RemoveFromNode(node, i);
+                return;
+            }
+            if (found) {
+                Node* left = node->children[i];
+                Node* right = node->children[i + 1];
+                if (left->count >= kMinDegree) {
+                    const Node* max = left;
+                    while (!max->leaf) {
+                        max = max->children[max->count];
+                    }
+                    key = max->keys[max->count - 1];
+                    node->keys[i] = key;
+                    node = left;
+                } else if (right->count >= kMinDegree) {
+                    const Node* min = right;
+                    while (!min->leaf) {
+                        min = min->children[0];
+                    }
+                    key = min->keys[0];
+                    node->keys[i] = key;
+                    node = right;
+                } else {
+                    Merge(node, i);
+                    node = left;
+                }
+                continue;
+            }
+            if (node->children[i]->count < kMinDegree) {
+                if (i > 0 && node->children[i - 1]->count >= kMinDegree) {
+                    RotateRight(node, i);
+                } else if (i < node->count && node->children[i + 1]->count >= kMinDegree) {
+                    RotateLeft(node, i);
+                } else if (i < node->count) {
+                    Merge(node, i);
+                } else {
+                    Merge(node, i - 1);
+                    --i;
+                }
+            }
+            node = node->children[i];
+        }
+    }
+
+    Compare compare_;
+    Node* root_ = nullptr;
+};
+
+}  // namespace aisd
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <aisd/sort/sort.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+namespace tree_detail {
+
+inline constexpr std::size_t kCacheLine = 64;
+
+// Allocator whose blocks start on a cache line boundary.
+template <class T>
+struct CacheLineAllocator {
+    using value_type = T;
+
+    CacheLineAllocator() = default;
+
+    template <class U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {
+    }
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{kCacheLine}));
+    }
+
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t{kCacheLine});
+    }
+
+    template <class U>
+    bool operator==(const CacheLineAllocator<U>&) const {
+        return true;
+    }
+
+    template <class U>
+    bool operator!=(const CacheLineAllocator<U>&) const {
+        return false;
+    }
+};
+
+}  // namespace tree_detail
+
+// Static ordered set in Eytzinger (BFS, implicit binary heap) layout.
+//
+// Node i has children 2i and 2i + 1, so the first levels of every search share
+// a handful of cache lines and the next levels can be prefetched. The array
+// starts on a cache line, so with S = 64 / sizeof(Key) keys per line the S
+// descendants log2(S) levels below node i, tree_[S * i, S * i + S), are
+// exactly one line: the search prefetches four levels ahead for 4-byte keys,
+// three for 8-byte keys. Key sizes that do not divide 64 still prefetch the
+// start of that block, which may straddle two lines. The search loop is
+// branchless. Rank maps the found node to its sorted position in O(1) and
+// Select descends by closed-form subtree sizes in O(log n), so no sorted copy
+// is kept. Build once from any key sequence; use BTreeSet for data that
+// changes.
+template <class Key, class Compare = std::less<Key>>
+class EytzingerSet {
+public:
+    EytzingerSet() = default;
+
+    explicit EytzingerSet(std::vector<Key> keys, Compare compare = Compare()) : compare_(std::move(compare)) {
+        Sort(keys.begin(), keys.end(), compare_);
+        auto equal = [this](const Key& a, const Key& b) { return !compare_(a, b) && !compare_(b, a); };
+        keys.erase(std::unique(keys.begin(), keys.end(), equal), keys.end());
+        size_ = keys.size();
+        tree_.resize(size_ + 1);
+        std::size_t next = 0;
+        Fill(keys, 1, next);
+        height_ = size_ == 0 ? 0 : Log2(size_);
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    // Number of keys < key.
+    std::size_t Rank(const Key& key) const {
+        std::size_t node = LowerBoundNode(key);
+        return node == 0 ? size_ : InOrderIndex(node);
+    }
+
+    bool Contains(const Key& key) const {
+        std::size_t node = LowerBoundNode(key);
+        return node != 0 && !compare_(key, tree_[node]);
+    }
+
+    // Smallest key >= key, or nullptr.
+    const Key* LowerBound(const Key& key) const {
+        std::size_t node = LowerBoundNode(key);
+        return node == 0 ? nullptr : &tree_[node];
+    }
+
+    // The node array: node i at index i, index 0 unused. Starts on a cache
+    // line.
+    const Key* Data() const {
+        return tree_.data();
+    }
+
+    // The rank-th smallest key, 0-based.
+    const Key& Select(std::size_t rank) const {
+        assert(rank < size_);
+        std::size_t node = 1;
+        while (true) {
+            std::size_t left = SubtreeSize(2 * node);
+            if (rank < left) {
+                node = 2 * node;
+            } else if (rank == left) {
+                return tree_[node];
+            } else {
+                rank -= left + 1;
+                node = 2 * node + 1;
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t kPrefetchStride =
+        sizeof(Key) >= tree_detail::kCacheLine ? 1 : tree_detail::kCacheLine / sizeof(Key);
+
+    static std::size_t Log2(std::size_t value) {
+        return static_cast<std::size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(value)));
+    }
+
+    void Fill(std::vector<Key>& keys, std::size_t node, std::size_t& next) {
+        if (node > size_) {
+            return;
+        }
+        Fill(keys, 2 * node, next);
+        tree_[node] = std::move(keys[next++]);
+        Fill(keys, 2 * node + 1, next);
+    }
+
+    // Eytzinger index of the smallest key >= key, 0 if there is none.
+    std::size_t LowerBoundNode(const Key& key) const {
+        const Key* tree = tree_.data();
+        std::size_t node = 1;
+        while (node <= size_) {
+            __builtin_prefetch(tree + node * kPrefetchStride);
+            node = 2 * node + compare_(tree[node], key);
+        }
+        // The path went right at every node < key; drop those trailing right
+        // turns plus the final left turn to land on the answer.
+        node >>= __builtin_ffsll(static_cast<long long>(~node));
+        return node;
+    }
+
+    // Number of nodes in the subtree rooted at node: all levels above the
+    // last one are full, the last one is filled left to right.
+    std::size_t SubtreeSize(std::size_t node) const {
+        if (node > size_) {
+            return 0;
+        }
+        std::size_t levels = height_ - Log2(node);
+        std::size_t full = (std::size_t{1} << levels) - 1;
+        std::size_t first_leaf = node << levels;
+        std::size_t last_level = size_ >= first_leaf ? std::min(size_ - first_leaf + 1, std::size_t{1} << levels) : 0;
+        return full + last_level;
+    }
+
+    // O(1): the in-order position of the node in the perfect tree of the same
+    // height, minus the missing last-level slots in front of it (in a perfect
+    // tree the last level occupies the even positions 0, 2, 4, ...).
+    std::size_t InOrderIndex(std::size_t node) const {
+        std::size_t depth = Log2(node);
+        std::size_t below = height_ - depth;
+        std::size_t perfect = ((node - (std::size_t{1} << depth)) << (below + 1)) + (std::size_t{1} << below) - 1;
+        std::size_t present_leaves = size_ - (std::size_t{1} << height_) + 1;
+        std::size_t leaf_slots_before = (perfect + 1) / 2;
+        return perfect - (leaf_slots_before > present_leaves ? leaf_slots_before - present_leaves : 0);
+    }
+
+    Compare compare_;
+    std::vector<Key, tree_detail::CacheLineAllocator<Key>> tree_;  // 1-based, tree_[0] unused
+    std::size_t size_ = 0;
+    std::size_t height_ = 0;
+};
+
+}  // namespace aisd
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace aisd {
+
+// Fenwick (binary indexed) tree over positions [0, n): point updates, prefix
+// and range sums in O(log n), all in one flat array.
+//
+// With 0/1 (or count) values it is a dynamic order-statistics index over a
+// bounded integer universe: PrefixSum(x) is the rank of x and
+// LowerBound(k + 1) selects the k-th present element.
+template <class T>
+class FenwickTree {
+public:
+    FenwickTree() = default;
+
+    explicit FenwickTree(std::size_t size) : tree_(size + 1, T()) {
+    }
+
+    // O(n) construction: every node pushes its total to its parent once.
+    explicit FenwickTree(const std::vector<T>& values) : tree_(values.size() + 1, T()) {
+        for (std::size_t i = 1; i < tree_.size(); ++i) {
+            tree_[i] += values[i - 1];
+            std::size_t parent = i + (i & (~i + 1));
+            if (parent < tree_.size()) {
+                tree_[parent] += tree_[i];
+            }
+        }
+    }
+
+    std::size_t Size() const {
+        return tree_.empty() ? 0 : tree_.size() - 1;
+    }
+
+    void Add(std::size_t index, T delta) {
+        assert(index < Size());
+        for (++index; index < tree_.size(); index += index & (~index + 1)) {
+            tree_[index] += delta;
+        }
+    }
+
+    // Sum of [0, end).
+    T PrefixSum(std::size_t end) const {
+        assert(end <= Size());
+        T sum = T();
+        for (; end > 0; end &= end - 1) {
+            sum += tree_[end];
+        }
+        return sum;
+    }
+
+    // Sum of [begin, end).
+    T RangeSum(std::size_t begin, std::size_t end) const {
+        assert(begin <= end);
+        return PrefixSum(end) - PrefixSum(begin);
+    }
+
+    // Smallest index such that PrefixSum(index + 1) >= target, or Size() if
+    // there is none. Requires non-negative values; binary lifting, O(log n).
+    std::size_t LowerBound(T target) const {
+        std::size_t position = 0;
+        std::size_t step = 1;
+        while (step * 2 < tree_.size()) {
+            step *= 2;
+        }
+        for (; step > 0; step /= 2) {
+            std::size_t next = position + step;
+            if (next < tree_.size() && tree_[next] < target) {
+                position = next;
+                target -= tree_[next];
+            }
+        }
+        return position;
+    }
+
+private:
+    std::vector<T> tree_;  // 1-based
+};
+
+}  // namespace aisd
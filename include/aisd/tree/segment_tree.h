@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace aisd {
+
+template <class T>
+struct SumMonoid {
+    static T Identity() {
+        return T();
+    }
+    T operator()(const T& a, const T& b) const {
+        return a + b;
+    }
+};
+
+template <class T>
+struct MinMonoid {
+    static T Identity() {
+        return std::numeric_limits<T>::max();
+    }
+    T operator()(const T& a, const T& b) const {
+        return std::min(a, b);
+    }
+};
+
+template <class T>
+struct MaxMonoid {
+    static T Identity() {
+        return std::numeric_limits<T>::lowest();
+    }
+    T operator()(const T& a, const T& b) const {
+        return std::max(a, b);
+    }
+};
+
+// Bottom-up segment tree over positions [0, n) for any associative Monoid
+// (Identity() plus a binary operator, not necessarily commutative).
+//
+// Leaves sit at [n, 2n) of a single array of 2n values and queries walk up
+// from both ends without recursion, which keeps the tree half the size of the
+// classic 4n recursive layout and the upper levels hot in cache.
+template <class T, class Monoid>
+class SegmentTree {
+public:
+    SegmentTree() = default;
+
+    explicit SegmentTree(std::size_t size, Monoid monoid = Monoid())
+        : monoid_(monoid), size_(size), tree_(2 * size, Monoid::Identity()) {
+    }
+
+    explicit SegmentTree(const std::vector<T>& values, Monoid monoid = Monoid())
+        : monoid_(monoid), size_(values.size()), tree_(2 * values.size()) {
+        std::copy(values.begin(), values.end(), tree_.begin() + size_);
+        for (std::size_t i = size_; i-- > 1;) {
+            tree_[i] = monoid_(tree_[2 * i], tree_[2 * i + 1]);
+        }
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    const T& Get(std::size_t index) const {
+        assert(index < size_);
+        return tree_[size_ + index];
+    }
+
+    void Set(std::size_t index, T value) {
+        assert(index < size_);
+        index += size_;
+        tree_[index] = std::move(value);
+        for (index /= 2; index > 0; index /= 2) {
+            tree_[index] = monoid_(tree_[2 * index], tree_[2 * index + 1]);
+        }
+    }
+
+    // Fold of [begin, end) in index order; Identity() for an empty range.
+    T Query(std::size_t begin, std::size_t end) const {
+        assert(begin <= end && end <= size_);
+        T left = Monoid::Identity();
+        T right = Monoid::Identity();
+        for (begin += size_, end += size_; begin < end; begin /= 2, end /= 2) {
+            if (begin & 1) {
+                left = monoid_(left, tree_[begin++]);
+            }
+            if (end & 1) {
+                right = monoid_(tree_[--end], right);
+            }
+        }
+        return monoid_(left, right);
+    }
+
+private:
+    Monoid monoid_;
+    std::size_t size_ = 0;
+    std::vector<T> tree_;
+};
+
+template <class T>
+using RangeSumTree = SegmentTree<T, SumMonoid<T>>;
+
+template <class T>
+using RangeMinTree = SegmentTree<T, MinMonoid<T>>;
+
+template <class T>
+using RangeMaxTree = SegmentTree<T, MaxMonoid<T>>;
+
+}  // namespace aisd
@@ -0,0 +1,162 @@
+#include "check.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
+
+namespace check {
+
+namespace {
+
+constexpr int kLoggedFailures = 5;
+
+struct TimingRow {
+    std::string name;
+    std::size_t n;
+    double subject_ms;
+    double reference_ms;
+};
+
+struct RunState {
+    std::uint64_t seed = 1;
+    std::string test;
+    int failures = 0;
+    std::FILE* log = nullptr;
+    std::vector<TimingRow> timings;
+};
+
+RunState& Current() {
+    static RunState state;
+    return state;
+}
+
+// Writes to stdout and, if open, to the log file.
+template <class... Args>
+void Print(const char* format, Args... args) {
+    std::printf(format, args...);
+    std::fflush(stdout);
+    if (Current().log != nullptr) {
+        std::fprintf(Current().log, format, args...);
+    }
+}
+
+// splitmix64 finalizer.
+std::uint64_t Mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+bool WriteTimings(const std::string& path) {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        return false;
+    }
+    std::fprintf(out, "%-48s %10s %12s %12s %8s\n", "case", "n", "subject_ms", "reference_ms", "speedup");
+    for (const TimingRow& row : Current().timings) {
+        double speedup = row.subject_ms > 0 ? row.reference_ms / row.subject_ms : 0;
+        std::fprintf(out, "%-48s %10zu %12.3f %12.3f %7.2fx\n", row.name.c_str(), row.n, row.subject_ms,
+                     row.reference_ms, speedup);
+    }
+    return std::fclose(out) == 0;
+}
+
+}  // namespace
+
+std::vector<Test>& Registry() {
+    static std::vector<Test> registry;
+    return registry;
+}
+
+Registrar::Registrar(const char* name, TestFn fn) {
+    Registry().push_back({name, std::move(fn)});
+}
+
+void Fail(const char* file, int line, const std::string& message) {
+    RunState& state = Current();
+    if (++state.failures <= kLoggedFailures) {
+        Print("  %s:%d: check failed: %s\n", file, line, message.c_str());
+    }
+}
+
+bool Failed() {
+    return Current().failures > 0;
+}
+
+std::uint64_t Seed() {
+    std::uint64_t hash = Current().seed;
+    for (char ch : Current().test) {
+        hash = Mix(hash ^ static_cast<unsigned char>(ch));
+    }
+    return hash;
+}
+
+std::string TempPath(const std::string& name) {
+    std::string file = name + "." + std::to_string(::getpid()) + "." + std::to_string(Seed());
+    return (std::filesystem::temp_directory_path() / file).string();
+}
+
+void RecordTiming(const std::string& name, std::size_t n, double subject_ms, double reference_ms) {
+    Current().timings.push_back({name, n, subject_ms, reference_ms});
+}
+
+int RunAll(const Options& options) {
+    RunState& state = Current();
+    state.seed = options.seed;
+    if (!options.test_output.empty()) {
+        state.log = std::fopen(options.test_output.c_str(), "w");
+        if (state.log == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", options.test_output.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<Test> tests = Registry();
+    std::sort(tests.begin(), tests.end(), [](const Test& a, const Test& b) { return a.name < b.name; });
+    int ran = 0;
+    int failed = 0;
+    for (const Test& test : tests) {
+        if (!options.filter.empty() && test.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        state.test = test.name;
+        state.failures = 0;
+        double ms = TimeMs([&] {
+            try {
+                test.fn();
+            } catch (const std::exception& e) {
+                Fail(__FILE__, __LINE__, std::string("uncaught exception: ") + e.what());
+            }
+        });
+        ++ran;
+        if (state.failures == 0) {
+            Print("[ OK ] %-40s %9.1f ms\n", test.name.c_str(), ms);
+        } else {
+            ++failed;
+            Print("[FAIL] %-40s %9.1f ms, %d failed checks\n", test.name.c_str(), ms, state.failures);
+        }
+    }
+    Print("%d tests, %d failed (seed %llu)\n", ran, failed, static_cast<unsigned long long>(options.seed));
+
+    if (state.log != nullptr) {
+        std::fclose(state.log);
+        state.log = nullptr;
+    }
+    if (!options.bench_output.empty() && !WriteTimings(options.bench_output)) {
+        std::fprintf(stderr, "cannot write %s\n", options.bench_output.c_str());
+        return 2;
+    }
+    if (ran == 0) {
+        std::fprintf(stderr, "no tests matched filter '%s'\n", options.filter.c_str());
+        return 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace check
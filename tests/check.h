@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace check {
+
+using TestFn = std::function<void()>;
+
+struct Test {
+    std::string name;
+    TestFn fn;
+};
+
+std::vector<Test>& Registry();
+
+struct Registrar {
+    Registrar(const char* name, TestFn fn);
+};
+
+// Records a failed check in the running test. The test goes on (so that one
+// run reports every broken routine); only the first few failures of a test
+// are logged.
+void Fail(const char* file, int line, const std::string& message);
+
+// True once the running test has failed a check; lets randomized loops stop
+// at the first divergence instead of repeating it thousands of times.
+bool Failed();
+
+// Generator seed of the running test: --seed mixed with the test name, so a
+// test sees the same inputs whichever subset of tests is run.
+std::uint64_t Seed();
+
+// Path in the temp directory for a scratch file of the running test: name
+// plus the pid and Seed(), so concurrent runs do not share files.
+std::string TempPath(const std::string& name);
+
+// Adds a row to the timing table written to bench_output.txt: the optimized
+// routine against its reference on one input of size n.
+void RecordTiming(const std::string& name, std::size_t n, double subject_ms, double reference_ms);
+
+template <class Fn>
+double TimeMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Options {
+    std::string filter;
+    std::uint64_t seed = 1;
+    std::string test_output;   // log copy, skipped if empty
+    std::string bench_output;  // timing table, skipped if empty
+};
+
+// Runs every registered test whose name contains options.filter; returns the
+// process exit code (0 if all checks passed).
+int RunAll(const Options& options);
+
+}  // namespace check
+
+#define CHECK_CONCAT_IMPL(a, b) a##b
+#define CHECK_CONCAT(a, b) CHECK_CONCAT_IMPL(a, b)
+
+// Registers a test body `void()`:
+//   TEST("sort/differential", [] { ... });
+#define TEST(...) static ::check::Registrar CHECK_CONCAT(check_registrar_, __LINE__)(__VA_ARGS__)
+
+#define CHECK(condition)                                      \
+    do {                                                      \
+        if (!(condition)) {                                   \
+            ::check::Fail(__FILE__, __LINE__, #condition);    \
+        }                                                     \
+    } while (false)
+
+// For printable values: logs both sides on failure.
+#define CHECK_EQ(a, b)                                                              \
+    do {                                                                            \
+        const auto& check_a = (a);                                                  \
+        const auto& check_b = (b);                                                  \
+        if (!(check_a == check_b)) {                                                \
+            std::ostringstream check_message;                                       \
+            check_message << #a " == " #b " (" << check_a << " vs " << check_b << ")"; \
+            ::check::Fail(__FILE__, __LINE__, check_message.str());                 \
+        }                                                                           \
+    } while (false)
@@ -0,0 +1,39 @@
+#include "check.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+void PrintUsage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--filter SUBSTR] [--seed S] [--test-output FILE] [--bench-output FILE]\n"
+                 "Checks every optimized routine against a naive or std reference on\n"
+                 "randomized inputs; --test-output keeps a copy of the log and\n"
+                 "--bench-output writes the subject/reference timing table.\n",
+                 argv0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    check::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--seed" && has_value) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--test-output" && has_value) {
+            options.test_output = argv[++i];
+        } else if (arg == "--bench-output" && has_value) {
+            options.bench_output = argv[++i];
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+    return check::RunAll(options);
+}
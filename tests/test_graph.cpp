@@ -0,0 +1,383 @@
+#include "check.h"
+
+#include <aisd/graph/bfs.h>
+#include <aisd/graph/boruvka_mst.h>
+#include <aisd/graph/csr_graph.h>
+#include <aisd/graph/delta_stepping.h>
+#include <aisd/graph/edge_list.h>
+#include <aisd/graph/union_find.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Graph = aisd::CsrGraph<std::uint32_t>;
+using Edges = std::vector<aisd::Edge<std::uint32_t>>;
+using Adjacency = std::vector<std::vector<std::pair<aisd::VertexId, std::uint32_t>>>;
+
+Edges MakeEdges(aisd::VertexId n, std::size_t m, std::uint32_t max_weight, std::mt19937_64& gen) {
+    Edges edges(m);
+    for (auto& edge : edges) {
+        edge.from = static_cast<aisd::VertexId>(gen() % n);
+        edge.to = static_cast<aisd::VertexId>(gen() % n);
+        edge.weight = static_cast<std::uint32_t>(gen() % max_weight);
+    }
+    return edges;
+}
+
+// Reference adjacency lists; self-loops are stored once when symmetrizing,
+// as in CsrGraph.
+Adjacency MakeAdjacency(aisd::VertexId n, const Edges& edges, bool symmetrize) {
+    Adjacency adjacency(n);
+    for (const auto& edge : edges) {
+        adjacency[edge.from].push_back({edge.to, edge.weight});
+        if (symmetrize && edge.from != edge.to) {
+            adjacency[edge.to].push_back({edge.from, edge.weight});
+        }
+    }
+    return adjacency;
+}
+
+std::vector<std::uint32_t> QueueBfs(const Adjacency& adjacency, aisd::VertexId source) {
+    std::vector<std::uint32_t> depth(adjacency.size(), aisd::kUnreachedDepth);
+    std::queue<aisd::VertexId> queue;
+    depth[source] = 0;
+    queue.push(source);
+    while (!queue.empty()) {
+        aisd::VertexId u = queue.front();
+        queue.pop();
+        for (auto [v, weight] : adjacency[u]) {
+            if (depth[v] == aisd::kUnreachedDepth) {
+                depth[v] = depth[u] + 1;
+                queue.push(v);
+            }
+        }
+    }
+    return depth;
+}
+
+std::vector<std::uint64_t> Dijkstra(const Adjacency& adjacency, aisd::VertexId source) {
+    using Item = std::pair<std::uint64_t, aisd::VertexId>;
+    std::vector<std::uint64_t> distance(adjacency.size(), aisd::kUnreachedDistance);
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+    distance[source] = 0;
+    queue.push({0, source});
+    while (!queue.empty()) {
+        auto [d, u] = queue.top();
+        queue.pop();
+        if (d != distance[u]) {
+            continue;
+        }
+        for (auto [v, weight] : adjacency[u]) {
+            if (d + weight < distance[v]) {
+                distance[v] = d + weight;
+                queue.push({distance[v], v});
+            }
+        }
+    }
+    return distance;
+}
+
+// Kruskal over the edge list: weight and edge count of a minimum spanning
+// forest.
+std::pair<std::uint64_t, std::size_t> Kruskal(aisd::VertexId n, Edges edges) {
+    std::sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) { return a.weight < b.weight; });
+    aisd::UnionFind components(n);
+    std::uint64_t weight = 0;
+    std::size_t count = 0;
+    for (const auto& edge : edges) {
+        if (components.Union(edge.from, edge.to)) {
+            weight += edge.weight;
+            ++count;
+        }
+    }
+    return {weight, count};
+}
+
+// Random multigraphs with self-loops and duplicate edges; the larger ones
+// push frontiers past graph_detail::kParallelFrontier so the parallel and
+// bottom-up BFS paths run.
+template <class Fn>
+void ForEachRandomGraph(int rounds, Fn&& fn) {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < rounds && !check::Failed(); ++round) {
+        auto n = static_cast<aisd::VertexId>(1 + gen() % (round < rounds * 2 / 3 ? 50 : 40000));
+        std::size_t m = gen() % (4 * std::size_t{n} + 1);
+        Edges edges = MakeEdges(n, m, round % 3 == 0 ? 3 : 1000, gen);
+        bool symmetrize = round % 2 == 0;
+        fn(n, edges, symmetrize, static_cast<aisd::VertexId>(gen() % n));
+    }
+}
+
+TEST("graph/csr", [] {
+    ForEachRandomGraph(300, [](aisd::VertexId n, const Edges& edges, bool symmetrize, aisd::VertexId) {
+        Graph graph = Graph::FromEdges(n, edges, symmetrize);
+        Adjacency adjacency = MakeAdjacency(n, edges, symmetrize);
+        CHECK_EQ(graph.VertexCount(), n);
+        Graph transpose = graph.Transpose();
+        Adjacency reversed(n);
+        for (aisd::VertexId v = 0; v < n && !check::Failed(); ++v) {
+            auto neighbors = graph.Neighbors(v);
+            auto weights = graph.NeighborWeights(v);
+            std::vector<std::pair<aisd::VertexId, std::uint32_t>> row;
+            for (std::size_t i = 0; i < neighbors.size(); ++i) {
+                row.push_back({neighbors[i], weights[i]});
+                reversed[neighbors[i]].push_back({v, weights[i]});
+            }
+            auto expected = adjacency[v];
+            std::sort(row.begin(), row.end());
+            std::sort(expected.begin(), expected.end());
+            CHECK(row == expected);
+        }
+        for (aisd::VertexId v = 0; v < n && !check::Failed(); ++v) {
+            auto neighbors = transpose.Neighbors(v);
+            auto weights = transpose.NeighborWeights(v);
+            std::vector<std::pair<aisd::VertexId, std::uint32_t>> row;
+            for (std::size_t i = 0; i < neighbors.size(); ++i) {
+                row.push_back({neighbors[i], weights[i]});
+            }
+            std::sort(row.begin(), row.end());
+            std::sort(reversed[v].begin(), reversed[v].end());
+            CHECK(row == reversed[v]);
+        }
+
+        // SortNeighbors orders each row by (weight, target) and keeps its
+        // contents.
+        Graph sorted = Graph::FromEdges(n, edges, symmetrize);
+        sorted.SortNeighbors(4);
+        CHECK(sorted.NeighborsSorted());
+        for (aisd::VertexId v = 0; v < n && !check::Failed(); ++v) {
+            auto neighbors = sorted.Neighbors(v);
+            auto weights = sorted.NeighborWeights(v);
+            std::vector<std::pair<std::uint32_t, aisd::VertexId>> row;
+            for (std::size_t i = 0; i < neighbors.size(); ++i) {
+                row.push_back({weights[i], neighbors[i]});
+            }
+            CHECK(std::is_sorted(row.begin(), row.end()));
+            CHECK_EQ(row.size(), adjacency[v].size());
+        }
+    });
+});
+
+TEST("graph/bfs", [] {
+    ForEachRandomGraph(300, [](aisd::VertexId n, const Edges& edges, bool symmetrize, aisd::VertexId source) {
+        Graph graph = Graph::FromEdges(n, edges, symmetrize, false);
+        Graph transpose = graph.Transpose();
+        auto expected = QueueBfs(MakeAdjacency(n, edges, symmetrize), source);
+        for (unsigned threads : {1u, 4u}) {
+            auto depth = symmetrize ? aisd::Bfs(graph, source, threads) : aisd::Bfs(graph, transpose, source, threads);
+            CHECK(depth == expected);
+        }
+    });
+});
+
+// Two dense clusters joined by a long path, searched from the first: the
+// search goes bottom-up inside the first cluster, top-down along the path and
+// bottom-up again in the second, so the unexplored-edge count must stay right
+// across several switches.
+TEST("graph/bfs_direction_switches", [] {
+    std::mt19937_64 gen(check::Seed());
+    constexpr aisd::VertexId kCluster = 1000;
+    constexpr aisd::VertexId kPath = 500;
+    constexpr aisd::VertexId kN = 2 * kCluster + kPath;
+    Edges edges;
+    for (aisd::VertexId base : {aisd::VertexId{0}, kCluster + kPath}) {
+        for (std::size_t i = 0; i < 200 * std::size_t{kCluster}; ++i) {
+            edges.push_back({static_cast<aisd::VertexId>(base + gen() % kCluster),
+                             static_cast<aisd::VertexId>(base + gen() % kCluster), 1});
+        }
+    }
+    for (aisd::VertexId v = kCluster - 1; v < kCluster + kPath; ++v) {
+        edges.push_back({v, v + 1, 1});
+    }
+    for (bool symmetrize : {true, false}) {
+        Graph graph = Graph::FromEdges(kN, edges, symmetrize, false);
+        Graph transpose = graph.Transpose();
+        auto expected = QueueBfs(MakeAdjacency(kN, edges, symmetrize), 0);
+        for (unsigned threads : {1u, 4u}) {
+            CHECK(aisd::Bfs(graph, transpose, 0, threads) == expected);
+        }
+    }
+});
+
+TEST("graph/delta_stepping", [] {
+    ForEachRandomGraph(200, [](aisd::VertexId n, const Edges& edges, bool symmetrize, aisd::VertexId source) {
+        Graph graph = Graph::FromEdges(n, edges, symmetrize);
+        auto expected = Dijkstra(MakeAdjacency(n, edges, symmetrize), source);
+        // delta 0 picks DefaultDelta; 1 is Dijkstra-like, 100000 Bellman-Ford-like.
+        for (std::uint64_t delta : {0u, 1u, 7u, 100000u}) {
+            for (unsigned threads : {1u, 4u}) {
+                CHECK(aisd::DeltaStepping(graph, source, delta, threads) == expected);
+            }
+        }
+    });
+});
+
+// Weights far above delta: most relaxations land beyond the bucket ring and
+// go through the far heap. The path graph reaches distances of 2^37 with
+// delta = 1, which a dense bucket array indexed by distance could not hold.
+TEST("graph/delta_stepping_heavy_weights", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 20 && !check::Failed(); ++round) {
+        auto n = static_cast<aisd::VertexId>(1 + gen() % (round < 10 ? 200 : 20000));
+        Edges edges = MakeEdges(n, gen() % (4 * std::size_t{n} + 1), 1u << 30, gen);
+        bool symmetrize = round % 2 == 0;
+        Graph graph = Graph::FromEdges(n, edges, symmetrize);
+        auto source = static_cast<aisd::VertexId>(gen() % n);
+        auto expected = Dijkstra(MakeAdjacency(n, edges, symmetrize), source);
+        for (std::uint64_t delta : {1u, 1000u, 1u << 20}) {
+            for (unsigned threads : {1u, 4u}) {
+                CHECK(aisd::DeltaStepping(graph, source, delta, threads) == expected);
+            }
+        }
+    }
+
+    constexpr aisd::VertexId kPath = 1 << 17;
+    constexpr std::uint32_t kWeight = 1 << 20;
+    Edges path;
+    for (aisd::VertexId v = 0; v + 1 < kPath; ++v) {
+        path.push_back({v, v + 1, kWeight});
+    }
+    Graph graph = Graph::FromEdges(kPath, path);
+    for (unsigned threads : {1u, 4u}) {
+        auto distance = aisd::DeltaStepping(graph, 0, 1, threads);
+        bool all_match = true;
+        for (aisd::VertexId v = 0; v < kPath; ++v) {
+            all_match = all_match && distance[v] == std::uint64_t{v} * kWeight;
+        }
+        CHECK(all_match);
+    }
+});
+
+TEST("graph/boruvka_mst", [] {
+    ForEachRandomGraph(300, [](aisd::VertexId n, const Edges& edges, bool, aisd::VertexId) {
+        auto [expected_weight, expected_count] = Kruskal(n, edges);
+        Graph graph = Graph::FromEdges(n, edges, true);
+        Graph sorted = Graph::FromEdges(n, edges, true);
+        sorted.SortNeighbors();
+        for (unsigned threads : {1u, 4u}) {
+            for (const Graph* input : {&graph, &sorted}) {
+                auto forest = aisd::BoruvkaMst(*input, threads);
+                aisd::UnionFind components(n);
+                std::uint64_t weight = 0;
+                bool acyclic = true;
+                for (const auto& edge : forest) {
+                    CHECK(edge.from < edge.to);
+                    weight += edge.weight;
+                    acyclic = components.Union(edge.from, edge.to) && acyclic;
+                }
+                CHECK(acyclic);
+                CHECK_EQ(weight, expected_weight);
+                CHECK_EQ(forest.size(), expected_count);
+            }
+        }
+    });
+});
+
+TEST("graph/union_find", [] {
+    std::mt19937_64 gen(check::Seed());
+    constexpr std::size_t kN = 2000;
+    aisd::UnionFind components(kN);
+    std::vector<std::size_t> label(kN);  // naive: relabel on every union
+    for (std::size_t v = 0; v < kN; ++v) {
+        label[v] = v;
+    }
+    std::size_t sets = kN;
+    for (int op = 0; op < 5000 && !check::Failed(); ++op) {
+        auto a = static_cast<aisd::VertexId>(gen() % kN);
+        auto b = static_cast<aisd::VertexId>(gen() % kN);
+        bool merged = label[a] != label[b];
+        if (merged) {
+            std::size_t old_label = label[b];
+            for (auto& value : label) {
+                value = value == old_label ? label[a] : value;
+            }
+            --sets;
+        }
+        CHECK_EQ(components.Union(a, b), merged);
+        auto c = static_cast<aisd::VertexId>(gen() % kN);
+        CHECK_EQ(components.Connected(a, c), label[a] == label[c]);
+        CHECK_EQ(components.SetCount(), sets);
+    }
+});
+
+TEST("graph/edge_list_io", [] {
+    std::mt19937_64 gen(check::Seed());
+    std::string path = check::TempPath("aisd_test_edges.bin");
+    for (int round = 0; round < 6 && !check::Failed(); ++round) {
+        auto n = static_cast<aisd::VertexId>(1 + gen() % 5000);
+        Edges edges = MakeEdges(n, gen() % 20000, 1000, gen);
+        edges.push_back({n - 1, 0, 1});  // the file does not store n: pin it via the largest id
+        bool symmetrize = round % 2 == 0;
+        Graph expected = Graph::FromEdges(n, edges, symmetrize);
+
+        aisd::SaveEdgeList(path, edges, true);
+        Graph weighted = aisd::LoadEdgeList<std::uint32_t>(path, true, symmetrize);
+        CHECK(weighted.Offsets() == expected.Offsets());
+        CHECK(weighted.Targets() == expected.Targets());
+        CHECK(weighted.Weights() == expected.Weights());
+
+        aisd::SaveEdgeList(path, edges, false);
+        Graph unweighted = aisd::LoadEdgeList<std::uint32_t>(path, false, symmetrize);
+        CHECK(unweighted.Offsets() == expected.Offsets());
+        CHECK(unweighted.Targets() == expected.Targets());
+        CHECK(!unweighted.HasWeights());
+    }
+
+    // A file that is not a whole number of records is rejected.
+    aisd::SaveEdgeList(path, Edges{{0, 1, 5}}, true);
+    std::filesystem::resize_file(path, aisd::EdgeRecordSize<std::uint32_t>(true) + 1);
+    bool threw = false;
+    try {
+        aisd::LoadEdgeList<std::uint32_t>(path, true);
+    } catch (const std::system_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::filesystem::remove(path);
+});
+
+TEST("graph/timing", [] {
+    std::mt19937_64 gen(check::Seed());
+    constexpr aisd::VertexId kN = 1 << 18;
+    Edges edges = MakeEdges(kN, 8 * std::size_t{kN}, 1000, gen);
+    Graph graph = Graph::FromEdges(kN, edges, true);
+    Adjacency adjacency = MakeAdjacency(kN, edges, true);
+
+    std::vector<std::uint32_t> depth;
+    std::vector<std::uint32_t> expected_depth;
+    double subject = check::TimeMs([&] { depth = aisd::Bfs(graph, 0); });
+    double reference = check::TimeMs([&] { expected_depth = QueueBfs(adjacency, 0); });
+    CHECK(depth == expected_depth);
+    check::RecordTiming("graph/bfs vs queue_bfs_adjacency_lists", graph.ArcCount(), subject, reference);
+
+    std::vector<std::uint64_t> distance;
+    std::vector<std::uint64_t> expected_distance;
+    subject = check::TimeMs([&] { distance = aisd::DeltaStepping(graph, 0); });
+    reference = check::TimeMs([&] { expected_distance = Dijkstra(adjacency, 0); });
+    CHECK(distance == expected_distance);
+    check::RecordTiming("graph/delta_stepping vs dijkstra", graph.ArcCount(), subject, reference);
+
+    std::vector<aisd::Edge<std::uint32_t>> forest;
+    std::pair<std::uint64_t, std::size_t> expected_forest;
+    subject = check::TimeMs([&] { forest = aisd::BoruvkaMst(graph); });
+    reference = check::TimeMs([&] { expected_forest = Kruskal(kN, edges); });
+    std::uint64_t weight = 0;
+    for (const auto& edge : forest) {
+        weight += edge.weight;
+    }
+    CHECK_EQ(weight, expected_forest.first);
+    CHECK_EQ(forest.size(), expected_forest.second);
+    check::RecordTiming("graph/boruvka_mst vs kruskal", graph.ArcCount(), subject, reference);
+});
+
+}  // namespace
@@ -0,0 +1,370 @@
+#include "check.h"
+
+#include <aisd/hash/robin_hood_map.h>
+#include <aisd/hash/string_arena.h>
+#include <aisd/hash/swiss_table.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Identity hash: with keys on a stride of 4096 every key would land in the
+// same few buckets if the tables did not remix the hash.
+struct IdentityHash {
+    std::size_t operator()(std::uint64_t key) const {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+template <class Map, class Reference>
+void CheckSameContents(const Map& map, const Reference& reference) {
+    CHECK_EQ(map.Size(), reference.size());
+    std::size_t seen = 0;
+    map.ForEach([&](const auto& slot) {
+        ++seen;
+        auto it = reference.find(slot.key);
+        CHECK(it != reference.end() && it->second == slot.value);
+    });
+    CHECK_EQ(seen, reference.size());
+}
+
+// Random insert / assign / erase / lookup churn against std::unordered_map.
+// A small key universe keeps the table full of tombstones (Swiss) and long
+// backward shifts (Robin Hood).
+template <class MakeMap>
+void CheckMap(MakeMap make_map, std::uint64_t stride) {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 12 && !check::Failed(); ++round) {
+        auto map = make_map();
+        std::unordered_map<std::uint64_t, std::uint64_t> reference;
+        std::uint64_t universe = round % 2 == 0 ? 64 : 20000;
+        if (round % 3 == 0) {
+            map.Reserve(gen() % 5000);
+        }
+        for (int op = 0; op < 20000 && !check::Failed(); ++op) {
+            std::uint64_t key = (gen() % universe) * stride;
+            std::uint64_t value = gen();
+            switch (gen() % 6) {
+                case 0:
+                    CHECK_EQ(map.Insert(key, value), reference.emplace(key, value).second);
+                    break;
+                case 1:
+                    map.InsertOrAssign(key, value);
+                    reference[key] = value;
+                    break;
+                case 2:
+                    map[key] += value;
+                    reference[key] += value;
+                    break;
+                case 3:
+                    CHECK_EQ(map.Erase(key), reference.erase(key) == 1);
+                    break;
+                default: {
+                    auto* found = map.FindValue(key);
+                    auto it = reference.find(key);
+                    CHECK((found == nullptr) == (it == reference.end()));
+                    CHECK(found == nullptr || *found == it->second);
+                    CHECK_EQ(map.Contains(key), it != reference.end());
+                    break;
+                }
+            }
+        }
+        CheckSameContents(map, reference);
+        auto moved = std::move(map);
+        CheckSameContents(moved, reference);
+        moved.Clear();
+        CHECK(moved.Empty());
+        CHECK(!moved.Contains(std::uint64_t{0}));
+    }
+}
+
+TEST("hash/swiss_map", [] {
+    using Map = aisd::FlatHashMap<std::uint64_t, std::uint64_t>;
+    CheckMap([] { return Map(); }, 1);
+    CheckMap([] { return Map(Map::kCompactMaxLoadFactor); }, 1);
+    using Strided = aisd::FlatHashMap<std::uint64_t, std::uint64_t, IdentityHash>;
+    CheckMap([] { return Strided(); }, 4096);
+});
+
+TEST("hash/robin_hood_map", [] {
+    using Map = aisd::RobinHoodMap<std::uint64_t, std::uint64_t>;
+    CheckMap([] { return Map(); }, 1);
+    CheckMap([] { return Map(Map::kCompactMaxLoadFactor); }, 1);
+    using Strided = aisd::RobinHoodMap<std::uint64_t, std::uint64_t, IdentityHash>;
+    CheckMap([] { return Strided(); }, 4096);
+});
+
+// Every key shares one hash, so the whole table is a single cluster.
+struct ConstantHash {
+    template <class Key>
+    std::size_t operator()(const Key&) const {
+        return 42;
+    }
+};
+
+// Counts key comparisons: a miss must not compare against empty slots.
+struct CountingEqual {
+    std::size_t* calls;
+
+    bool operator()(std::uint64_t a, std::uint64_t b) const {
+        ++*calls;
+        return a == b;
+    }
+};
+
+TEST("hash/colliding_hashes", [] {
+    // 255 colliding keys fill every probe distance a Robin Hood byte can hold.
+    std::size_t calls = 0;
+    aisd::RobinHoodMap<std::uint64_t, std::uint64_t, ConstantHash, CountingEqual> robin_hood(
+        0.9, ConstantHash(), CountingEqual{&calls});
+    constexpr std::uint64_t kFull = 255;
+    for (std::uint64_t key = 0; key < kFull; ++key) {
+        CHECK(robin_hood.Insert(key, key * 3));
+    }
+    for (std::uint64_t key = 0; key < kFull + 10; ++key) {
+        calls = 0;
+        const std::uint64_t* value = robin_hood.FindValue(key);
+        CHECK_EQ(value != nullptr, key < kFull);
+        CHECK(value == nullptr || *value == key * 3);
+        CHECK(calls <= kFull);
+    }
+
+    // One more cannot be placed and doubling would not help: the insert
+    // throws and the map keeps its contents.
+    bool threw = false;
+    try {
+        robin_hood.Insert(kFull, std::uint64_t{0});
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK_EQ(robin_hood.Size(), kFull);
+    CHECK(robin_hood.Capacity() <= 4096);
+    for (std::uint64_t key = 0; key < kFull; key += 2) {
+        CHECK(robin_hood.Erase(key));
+    }
+    for (std::uint64_t key = 0; key < kFull; ++key) {
+        CHECK_EQ(robin_hood.Contains(key), key % 2 == 1);
+    }
+
+    // A throwing insert must not have moved from its arguments either.
+    aisd::RobinHoodMap<std::string, std::string, ConstantHash> strings;
+    for (std::uint64_t key = 0; key < kFull; ++key) {
+        CHECK(strings.Insert(std::to_string(key), std::string()));
+    }
+    std::string key(100, 'k');
+    std::string value(100, 'v');
+    threw = false;
+    try {
+        strings.Insert(std::move(key), std::move(value));
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        strings[std::move(key)] = "unused";
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(key == std::string(100, 'k') && value == std::string(100, 'v'));
+    CHECK_EQ(strings.Size(), kFull);
+
+    // The Swiss table probes by group and handles any number of them.
+    aisd::FlatHashMap<std::uint64_t, std::uint64_t, ConstantHash> swiss;
+    for (std::uint64_t key = 0; key < 600; ++key) {
+        CHECK(swiss.Insert(key, key));
+    }
+    for (std::uint64_t key = 0; key < 700; ++key) {
+        CHECK_EQ(swiss.Contains(key), key < 600);
+    }
+});
+
+// Copying a value whose text is "throw" throws.
+struct FragileValue {
+    std::string text;
+
+    explicit FragileValue(std::string t) : text(std::move(t)) {}
+    FragileValue(FragileValue&&) = default;
+    FragileValue& operator=(FragileValue&&) = default;
+    FragileValue& operator=(const FragileValue&) = default;
+
+    FragileValue(const FragileValue& other) : text(other.text) {
+        if (text == "throw") {
+            throw std::runtime_error("FragileValue copy");
+        }
+    }
+};
+
+TEST("hash/swiss_throwing_insert", [] {
+    // A slot whose construction throws must not be left looking full: Find,
+    // ForEach and the destructor would touch an object that never existed.
+    aisd::FlatHashMap<std::uint64_t, FragileValue> map;
+    const FragileValue fragile("throw");
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        if (key % 3 == 0) {
+            bool threw = false;
+            try {
+                map.Insert(key, fragile);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            CHECK(threw);
+        } else {
+            CHECK(map.Insert(key, FragileValue(std::to_string(key))));
+        }
+    }
+    CHECK_EQ(map.Size(), std::size_t{666});
+    std::size_t seen = 0;
+    map.ForEach([&](const auto& slot) {
+        ++seen;
+        CHECK(slot.key % 3 != 0 && slot.value.text == std::to_string(slot.key));
+    });
+    CHECK_EQ(seen, map.Size());
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        CHECK_EQ(map.Contains(key), key % 3 != 0);
+    }
+});
+
+TEST("hash/swiss_set", [] {
+    std::mt19937_64 gen(check::Seed());
+    aisd::FlatHashSet<std::uint64_t> set;
+    std::unordered_set<std::uint64_t> reference;
+    for (int op = 0; op < 100000 && !check::Failed(); ++op) {
+        std::uint64_t key = gen() % 5000;
+        if (gen() % 3 != 0) {
+            CHECK_EQ(set.Insert(key), reference.insert(key).second);
+        } else {
+            CHECK_EQ(set.Erase(key), reference.erase(key) == 1);
+        }
+        std::uint64_t probe = gen() % 5000;
+        CHECK_EQ(set.Contains(probe), reference.count(probe) == 1);
+    }
+    CHECK_EQ(set.Size(), reference.size());
+    for (std::uint64_t key = 0; key < 5000; ++key) {
+        CHECK_EQ(set.Contains(key), reference.count(key) == 1);
+    }
+});
+
+std::string RandomWord(std::mt19937_64& gen) {
+    std::string word(gen() % 20, 'a');
+    for (auto& ch : word) {
+        ch = static_cast<char>('a' + gen() % 4);
+    }
+    return word;
+}
+
+TEST("hash/arena_strings", [] {
+    std::mt19937_64 gen(check::Seed());
+    aisd::ArenaStringMap<std::uint64_t> map;
+    aisd::ArenaStringSet<> set;
+    std::unordered_map<std::string, std::uint64_t> reference;
+    for (int op = 0; op < 50000 && !check::Failed(); ++op) {
+        // The key buffer is overwritten afterwards: the map must own a copy.
+        std::string key = RandomWord(gen);
+        std::uint64_t value = gen();
+        switch (gen() % 4) {
+            case 0:
+                CHECK_EQ(map.Insert(key, value), reference.emplace(key, value).second);
+                set.Insert(key);
+                break;
+            case 1:
+                map[key] += value;
+                reference[key] += value;
+                set.Insert(key);
+                break;
+            case 2:
+                CHECK_EQ(map.Erase(key), reference.erase(key) == 1);
+                set.Erase(key);
+                break;
+            default: {
+                auto* found = map.FindValue(key);
+                auto it = reference.find(key);
+                CHECK((found == nullptr) == (it == reference.end()));
+                CHECK(found == nullptr || *found == it->second);
+                break;
+            }
+        }
+        key.assign(key.size(), '#');
+    }
+    CHECK_EQ(map.Size(), reference.size());
+    CHECK_EQ(set.Size(), reference.size());
+    map.ForEach([&](const auto& slot) {
+        auto it = reference.find(std::string(slot.key));
+        CHECK(it != reference.end() && it->second == slot.value);
+    });
+    set.ForEach([&](std::string_view key) { CHECK(reference.count(std::string(key)) == 1); });
+    CHECK(map.Arena().BytesUsed() <= map.Arena().BytesReserved());
+});
+
+// n inserts, then n lookups of which half hit, against std::unordered_map.
+template <class Map>
+void TimeInsertLookup(const char* name, const std::vector<std::uint64_t>& keys) {
+    std::uint64_t subject_hits = 0;
+    std::uint64_t reference_hits = 0;
+    double subject = check::TimeMs([&] {
+        Map map;
+        for (std::uint64_t key : keys) {
+            map.Insert(key, key);
+        }
+        for (std::uint64_t key : keys) {
+            subject_hits += map.Contains(key ^ (key & 1));
+        }
+    });
+    double reference = check::TimeMs([&] {
+        std::unordered_map<std::uint64_t, std::uint64_t> map;
+        for (std::uint64_t key : keys) {
+            map.emplace(key, key);
+        }
+        for (std::uint64_t key : keys) {
+            reference_hits += map.count(key ^ (key & 1));
+        }
+    });
+    CHECK_EQ(subject_hits, reference_hits);
+    check::RecordTiming(name, keys.size(), subject, reference);
+}
+
+TEST("hash/timing", [] {
+    std::mt19937_64 gen(check::Seed());
+    std::vector<std::uint64_t> keys(1 << 20);
+    for (auto& key : keys) {
+        key = gen();
+    }
+    TimeInsertLookup<aisd::FlatHashMap<std::uint64_t, std::uint64_t>>("hash/swiss vs std_unordered_map", keys);
+    TimeInsertLookup<aisd::RobinHoodMap<std::uint64_t, std::uint64_t>>("hash/robin_hood vs std_unordered_map",
+                                                                        keys);
+
+    std::vector<std::string> words(1 << 19);
+    for (auto& word : words) {
+        word = std::to_string(gen() % (1 << 18)) + "/key";
+    }
+    std::size_t subject_size = 0;
+    std::size_t reference_size = 0;
+    double subject = check::TimeMs([&] {
+        aisd::ArenaStringMap<std::uint32_t> map;
+        for (const auto& word : words) {
+            ++map[word];
+        }
+        subject_size = map.Size();
+    });
+    double reference = check::TimeMs([&] {
+        std::unordered_map<std::string, std::uint32_t> map;
+        for (const auto& word : words) {
+            ++map[word];
+        }
+        reference_size = map.size();
+    });
+    CHECK_EQ(subject_size, reference_size);
+    check::RecordTiming("hash/arena_string_count vs std_unordered_map", words.size(), subject, reference);
+});
+
+}  // namespace
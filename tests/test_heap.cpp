@@ -0,0 +1,203 @@
+#include "check.h"
+
+#include <aisd/heap/d_ary_heap.h>
+#include <aisd/heap/pairing_heap.h>
+#include <aisd/heap/radix_heap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Naive reference: live (handle, key) pairs in a vector, minimum by linear
+// scan.
+struct NaiveHeap {
+    struct Entry {
+        aisd::HeapHandle handle;
+        std::uint64_t key;
+    };
+    std::vector<Entry> entries;
+
+    template <class Compare>
+    std::uint64_t TopKey(Compare compare) const {
+        auto best = entries.front().key;
+        for (const auto& entry : entries) {
+            if (compare(entry.key, best)) {
+                best = entry.key;
+            }
+        }
+        return best;
+    }
+
+    Entry* Find(aisd::HeapHandle handle) {
+        for (auto& entry : entries) {
+            if (entry.handle == handle) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void Remove(aisd::HeapHandle handle) {
+        for (auto& entry : entries) {
+            if (entry.handle == handle) {
+                entry = entries.back();
+                entries.pop_back();
+                return;
+            }
+        }
+    }
+};
+
+// Random push / pop / decrease-key / erase mix against NaiveHeap. With
+// monotone set, keys never go below the last popped minimum (radix heap
+// contract).
+template <class Heap, class Compare = std::less<>>
+void CheckHeap(bool monotone, Compare compare = Compare()) {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 60 && !check::Failed(); ++round) {
+        Heap heap;
+        NaiveHeap naive;
+        std::uint64_t key_range = round % 3 == 0 ? 8 : 1'000'000;  // many ties or few
+        std::uint64_t floor = 0;
+        int ops = 100 + static_cast<int>(gen() % 3000);
+        for (int op = 0; op < ops && !check::Failed(); ++op) {
+            std::uint64_t kind = gen() % 10;
+            if (naive.entries.empty() || kind < 4) {
+                std::uint64_t key = floor + gen() % key_range;
+                naive.entries.push_back({heap.Push(key), key});
+            } else if (kind < 7) {
+                CHECK_EQ(heap.Top(), naive.TopKey(compare));
+                aisd::HeapHandle top = heap.TopHandle();
+                auto* entry = naive.Find(top);
+                CHECK(entry != nullptr && entry->key == heap.Top());
+                if (monotone) {
+                    floor = heap.Top();
+                }
+                heap.Pop();
+                CHECK(!heap.Contains(top));
+                naive.Remove(top);
+            } else if (kind < 9) {
+                auto& entry = naive.entries[gen() % naive.entries.size()];
+                CHECK(heap.Contains(entry.handle));
+                CHECK_EQ(heap.KeyOf(entry.handle), entry.key);
+                std::uint64_t key = entry.key;
+                if (compare(0, 1)) {
+                    key = std::max(floor, key - std::min(key, gen() % key_range));
+                } else {
+                    key += gen() % key_range;
+                }
+                heap.DecreaseKey(entry.handle, key);
+                entry.key = key;
+            } else {
+                auto handle = naive.entries[gen() % naive.entries.size()].handle;
+                heap.Erase(handle);
+                CHECK(!heap.Contains(handle));
+                naive.Remove(handle);
+            }
+            CHECK_EQ(heap.Size(), naive.entries.size());
+        }
+        // Drain: pops must come out in order.
+        while (!heap.Empty() && !check::Failed()) {
+            CHECK_EQ(heap.Top(), naive.TopKey(compare));
+            naive.Remove(heap.TopHandle());
+            heap.Pop();
+        }
+        CHECK(naive.entries.empty());
+    }
+}
+
+TEST("heap/d_ary", [] {
+    CheckHeap<aisd::DAryHeap<std::uint64_t, 2>>(false);
+    CheckHeap<aisd::DAryHeap<std::uint64_t, 4>>(false);
+    CheckHeap<aisd::DAryHeap<std::uint64_t, 8>>(false);
+    CheckHeap<aisd::DAryHeap<std::uint64_t, 4, std::greater<>>>(false, std::greater<>());
+});
+
+TEST("heap/pairing", [] {
+    CheckHeap<aisd::PairingHeap<std::uint64_t>>(false);
+    CheckHeap<aisd::PairingHeap<std::uint64_t, std::greater<>>>(false, std::greater<>());
+});
+
+TEST("heap/radix", [] {
+    CheckHeap<aisd::RadixHeap<std::uint64_t>>(true);
+    CheckHeap<aisd::RadixHeap<std::uint32_t>>(true);
+});
+
+TEST("heap/clear_and_reuse", [] {
+    std::mt19937_64 gen(check::Seed());
+    aisd::DAryHeap<std::uint64_t> d_ary;
+    aisd::PairingHeap<std::uint64_t> pairing;
+    aisd::RadixHeap<std::uint64_t> radix;
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::uint64_t> keys(1000);
+        for (auto& key : keys) {
+            key = gen() % 5000;
+            d_ary.Push(key);
+            pairing.Push(key);
+            radix.Push(key);
+        }
+        std::sort(keys.begin(), keys.end());
+        for (std::uint64_t key : keys) {
+            CHECK_EQ(d_ary.Top(), key);
+            CHECK_EQ(pairing.Top(), key);
+            CHECK_EQ(radix.Top(), key);
+            d_ary.Pop();
+            pairing.Pop();
+            radix.Pop();
+        }
+        d_ary.Push(1);
+        pairing.Push(1);
+        radix.Push(radix.LastMin());
+        d_ary.Clear();
+        pairing.Clear();
+        radix.Clear();
+        CHECK(d_ary.Empty() && pairing.Empty() && radix.Empty());
+    }
+});
+
+// Heapsort-style push-all / pop-all against std::priority_queue.
+template <class Heap>
+void TimePushPop(const char* name, const std::vector<std::uint64_t>& keys) {
+    std::uint64_t subject_sum = 0;
+    std::uint64_t reference_sum = 0;
+    double subject = check::TimeMs([&] {
+        Heap heap;
+        for (std::uint64_t key : keys) {
+            heap.Push(key);
+        }
+        for (std::size_t i = 1; !heap.Empty(); ++i) {
+            subject_sum += heap.Top() * i;
+            heap.Pop();
+        }
+    });
+    double reference = check::TimeMs([&] {
+        std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<>> heap;
+        for (std::uint64_t key : keys) {
+            heap.push(key);
+        }
+        for (std::size_t i = 1; !heap.empty(); ++i) {
+            reference_sum += heap.top() * i;
+            heap.pop();
+        }
+    });
+    CHECK_EQ(subject_sum, reference_sum);
+    check::RecordTiming(name, keys.size(), subject, reference);
+}
+
+TEST("heap/timing", [] {
+    std::mt19937_64 gen(check::Seed());
+    std::vector<std::uint64_t> keys(1 << 20);
+    for (auto& key : keys) {
+        key = gen() >> 24;
+    }
+    TimePushPop<aisd::DAryHeap<std::uint64_t, 4>>("heap/d_ary_4 vs std_priority_queue", keys);
+    TimePushPop<aisd::PairingHeap<std::uint64_t>>("heap/pairing vs std_priority_queue", keys);
+    TimePushPop<aisd::RadixHeap<std::uint64_t>>("heap/radix vs std_priority_queue", keys);
+});
+
+}  // namespace
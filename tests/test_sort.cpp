@@ -0,0 +1,237 @@
+#include "check.h"
+
+#include <aisd/sort/block_quicksort.h>
+#include <aisd/sort/multiway_merge_sort.h>
+#include <aisd/sort/radix_sort.h>
+#include <aisd/sort/sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Input shapes that exercise the partitioning and pass-skipping paths:
+// random, few distinct keys, sorted, reversed, organ pipe, all equal, and
+// keys confined to the low bits.
+enum class Shape { kRandom, kFewUnique, kSorted, kReversed, kOrganPipe, kEqual, kSmallRange, kCount };
+
+template <class Int>
+std::vector<Int> MakeInts(std::size_t n, Shape shape, std::mt19937_64& gen) {
+    std::vector<Int> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (shape) {
+            case Shape::kFewUnique:
+                values[i] = static_cast<Int>(gen() % 7) - static_cast<Int>(3 * std::is_signed_v<Int>);
+                break;
+            case Shape::kSmallRange:
+                values[i] = static_cast<Int>(gen() % 1000);
+                break;
+            case Shape::kEqual:
+                values[i] = static_cast<Int>(42);
+                break;
+            default:
+                values[i] = static_cast<Int>(gen());
+                break;
+        }
+    }
+    if (shape == Shape::kSorted || shape == Shape::kReversed || shape == Shape::kOrganPipe) {
+        std::sort(values.begin(), values.end());
+    }
+    if (shape == Shape::kReversed) {
+        std::reverse(values.begin(), values.end());
+    }
+    if (shape == Shape::kOrganPipe) {
+        std::reverse(values.begin() + static_cast<std::ptrdiff_t>(n / 2), values.end());
+    }
+    return values;
+}
+
+std::vector<std::string> MakeWords(std::size_t n, std::mt19937_64& gen) {
+    std::vector<std::string> words(n);
+    for (auto& word : words) {
+        // Shared prefixes and embedded zero bytes reach deep MSD levels.
+        std::size_t length = gen() % 12;
+        word.assign(gen() % 3 == 0 ? "prefix/" : "");
+        for (std::size_t i = 0; i < length; ++i) {
+            word.push_back(static_cast<char>(gen() % 4 == 0 ? gen() % 256 : 'a' + gen() % 3));
+        }
+    }
+    return words;
+}
+
+// Sizes around the insertion-sort cutoff, the block size and the parallel
+// threshold, plus random ones.
+std::vector<std::size_t> Sizes(std::mt19937_64& gen) {
+    std::vector<std::size_t> sizes = {0, 1, 2, 3, 23, 24, 25, 63, 64, 65, 128, 129, 1000};
+    for (int i = 0; i < 20; ++i) {
+        sizes.push_back(gen() % 5000);
+    }
+    return sizes;
+}
+
+template <class Int, class SortFn, class Compare = std::less<>>
+void CheckIntSort(SortFn sort_fn, Compare comp = Compare()) {
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : Sizes(gen)) {
+        for (int shape = 0; shape < static_cast<int>(Shape::kCount) && !check::Failed(); ++shape) {
+            auto values = MakeInts<Int>(n, static_cast<Shape>(shape), gen);
+            auto expected = values;
+            std::sort(expected.begin(), expected.end(), comp);
+            sort_fn(values);
+            CHECK(values == expected);
+        }
+    }
+}
+
+TEST("sort/aisd_sort/integers", [] {
+    CheckIntSort<std::uint64_t>([](auto& v) { aisd::Sort(v.begin(), v.end()); });
+    CheckIntSort<std::int32_t>([](auto& v) { aisd::Sort(v.begin(), v.end()); });
+    CheckIntSort<std::int64_t>([](auto& v) { aisd::Sort(v.begin(), v.end(), std::greater<>(), 1); },
+                               std::greater<>());
+});
+
+TEST("sort/aisd_sort/strings_and_doubles", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : Sizes(gen)) {
+        auto words = MakeWords(n, gen);
+        auto expected = words;
+        std::sort(expected.begin(), expected.end());
+        aisd::Sort(words.begin(), words.end());
+        CHECK(words == expected);
+
+        std::vector<double> doubles(n);
+        for (auto& value : doubles) {
+            value = static_cast<double>(gen() % 1000) / 7.0 - 50;
+        }
+        auto expected_doubles = doubles;
+        std::sort(expected_doubles.begin(), expected_doubles.end());
+        aisd::Sort(doubles.begin(), doubles.end());
+        CHECK(doubles == expected_doubles);
+    }
+});
+
+TEST("sort/aisd_sort/parallel", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (int shape = 0; shape < static_cast<int>(Shape::kCount); ++shape) {
+        auto values = MakeInts<std::uint64_t>((1 << 20) + 12345, static_cast<Shape>(shape), gen);
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        aisd::Sort(values.begin(), values.end(), std::less<>(), 4);
+        CHECK(values == expected);
+    }
+    auto words = MakeWords(1 << 20, gen);
+    auto expected = words;
+    std::sort(expected.begin(), expected.end());
+    aisd::Sort(words.begin(), words.end(), std::less<>(), 4);
+    CHECK(words == expected);
+});
+
+TEST("sort/block_quicksort", [] {
+    CheckIntSort<std::uint32_t>([](auto& v) { aisd::BlockQuicksort(v.begin(), v.end()); });
+    // Non-trivial element type with a custom comparator.
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : Sizes(gen)) {
+        std::vector<std::pair<int, std::string>> values(n);
+        for (auto& value : values) {
+            value = {static_cast<int>(gen() % 50), std::to_string(gen() % 100)};
+        }
+        auto expected = values;
+        auto by_first_desc = [](const auto& a, const auto& b) { return a.first > b.first; };
+        std::stable_sort(expected.begin(), expected.end(), by_first_desc);
+        aisd::BlockQuicksort(values.begin(), values.end(), by_first_desc);
+        CHECK(std::is_sorted(values.begin(), values.end(), by_first_desc));
+        std::sort(values.begin(), values.end());
+        std::sort(expected.begin(), expected.end());
+        CHECK(values == expected);
+    }
+});
+
+TEST("sort/lsd_radix", [] {
+    CheckIntSort<std::uint64_t>([](auto& v) { aisd::LsdRadixSort(v.data(), v.data() + v.size()); });
+    CheckIntSort<std::int16_t>([](auto& v) { aisd::LsdRadixSort(v.data(), v.data() + v.size()); });
+    CheckIntSort<std::int64_t>([](auto& v) { aisd::LsdRadixSort(v.data(), v.data() + v.size()); });
+
+    // Sorting by a key must be stable.
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : Sizes(gen)) {
+        std::vector<std::pair<std::int32_t, std::uint32_t>> records(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            records[i] = {static_cast<std::int32_t>(gen() % 64) - 32, static_cast<std::uint32_t>(i)};
+        }
+        auto expected = records;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        aisd::LsdRadixSort(records.data(), records.data() + n, [](const auto& record) { return record.first; });
+        CHECK(records == expected);
+    }
+});
+
+TEST("sort/msd_radix", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : Sizes(gen)) {
+        auto words = MakeWords(n, gen);
+        auto expected = words;
+        std::sort(expected.begin(), expected.end());
+        aisd::MsdRadixSort(words.data(), words.data() + n);
+        CHECK(words == expected);
+    }
+    // Long common prefixes must not blow the stack.
+    std::vector<std::string> deep(2000, std::string(5000, 'x'));
+    for (std::size_t i = 0; i < deep.size(); ++i) {
+        deep[i] += std::to_string(gen() % 100);
+    }
+    auto expected = deep;
+    std::sort(expected.begin(), expected.end());
+    aisd::MsdRadixSort(deep.data(), deep.data() + deep.size());
+    CHECK(deep == expected);
+});
+
+TEST("sort/parallel_multiway_merge", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : {std::size_t{0}, std::size_t{5000}, std::size_t{4096 * 4}, std::size_t{300000}}) {
+        for (int shape = 0; shape < static_cast<int>(Shape::kCount); ++shape) {
+            auto values = MakeInts<std::int64_t>(n, static_cast<Shape>(shape), gen);
+            auto expected = values;
+            std::sort(expected.begin(), expected.end());
+            for (unsigned threads : {1u, 3u, 4u}) {
+                auto copy = values;
+                aisd::ParallelMultiwayMergeSort(copy.begin(), copy.end(), std::less<>(), threads);
+                CHECK(copy == expected);
+            }
+        }
+    }
+});
+
+TEST("sort/timing", [] {
+    std::mt19937_64 gen(check::Seed());
+    constexpr std::size_t kN = 1 << 22;
+    auto values = MakeInts<std::uint64_t>(kN, Shape::kRandom, gen);
+    auto reference = values;
+    double subject = check::TimeMs([&] { aisd::Sort(values.begin(), values.end()); });
+    double baseline = check::TimeMs([&] { std::sort(reference.begin(), reference.end()); });
+    CHECK(values == reference);
+    check::RecordTiming("sort/u64/aisd_sort vs std_sort", kN, subject, baseline);
+
+    values = MakeInts<std::uint64_t>(kN, Shape::kRandom, gen);
+    reference = values;
+    subject = check::TimeMs([&] { aisd::BlockQuicksort(values.begin(), values.end()); });
+    baseline = check::TimeMs([&] { std::sort(reference.begin(), reference.end()); });
+    CHECK(values == reference);
+    check::RecordTiming("sort/u64/block_quicksort vs std_sort", kN, subject, baseline);
+
+    constexpr std::size_t kWords = 1 << 19;
+    auto words = MakeWords(kWords, gen);
+    auto reference_words = words;
+    subject = check::TimeMs([&] { aisd::Sort(words.begin(), words.end()); });
+    baseline = check::TimeMs([&] { std::sort(reference_words.begin(), reference_words.end()); });
+    CHECK(words == reference_words);
+    check::RecordTiming("sort/string/aisd_sort vs std_sort", kWords, subject, baseline);
+});
+
+}  // namespace
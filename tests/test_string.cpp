@@ -0,0 +1,213 @@
+#include "check.h"
+
+#include <aisd/string/aho_corasick.h>
+#include <aisd/string/mapped_file.h>
+#include <aisd/string/string_search.h>
+#include <aisd/string/suffix_array.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Short random texts: tiny alphabets give long repeats (deep SA-IS recursion),
+// every seventh text uses all 256 byte values.
+std::string MakeText(std::size_t n, int round, std::mt19937_64& gen) {
+    std::size_t sigma = 1 + gen() % (round % 3 == 0 ? 2 : 26);
+    std::string text(n, 'a');
+    for (auto& ch : text) {
+        ch = static_cast<char>(round % 7 == 0 ? gen() % 256 : 'a' + gen() % sigma);
+    }
+    return text;
+}
+
+std::vector<std::int32_t> NaiveSuffixArray(std::string_view text) {
+    std::vector<std::int32_t> sa(text.size());
+    for (std::size_t i = 0; i < sa.size(); ++i) {
+        sa[i] = static_cast<std::int32_t>(i);
+    }
+    std::sort(sa.begin(), sa.end(), [&](std::int32_t a, std::int32_t b) { return text.substr(a) < text.substr(b); });
+    return sa;
+}
+
+std::size_t NaiveCommonPrefix(std::string_view text, std::size_t a, std::size_t b) {
+    std::size_t length = 0;
+    while (a + length < text.size() && b + length < text.size() && text[a + length] == text[b + length]) {
+        ++length;
+    }
+    return length;
+}
+
+TEST("string/suffix_and_lcp_arrays", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 2000 && !check::Failed(); ++round) {
+        std::string text = MakeText(gen() % (round < 1000 ? 20 : 300), round, gen);
+        auto sa = aisd::SuffixArray(text);
+        auto expected = NaiveSuffixArray(text);
+        CHECK(sa == expected);
+        auto sa64 = aisd::SuffixArray<std::int64_t>(text);
+        CHECK(std::equal(sa64.begin(), sa64.end(), expected.begin(), expected.end()));
+        auto lcp = aisd::LcpArray(text, sa);
+        CHECK_EQ(lcp.size(), text.size());
+        for (std::size_t i = 1; i < lcp.size(); ++i) {
+            CHECK_EQ(static_cast<std::size_t>(lcp[i]), NaiveCommonPrefix(text, expected[i - 1], expected[i]));
+        }
+    }
+});
+
+TEST("string/aho_corasick", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 2000 && !check::Failed(); ++round) {
+        std::string text = MakeText(gen() % 300, round, gen);
+        aisd::AhoCorasick automaton;
+        std::vector<std::string> patterns(1 + gen() % 10);
+        for (auto& pattern : patterns) {
+            // Short patterns over the text's alphabet; duplicates and empty
+            // patterns included.
+            pattern.resize(gen() % 4);
+            for (auto& ch : pattern) {
+                ch = text.empty() ? 'a' : text[gen() % text.size()];
+            }
+            automaton.AddPattern(pattern);
+        }
+        automaton.Build();
+
+        // Feed in random-sized chunks: matches must not depend on where the
+        // text is split.
+        std::multiset<std::pair<std::size_t, std::size_t>> found;
+        aisd::AhoCorasick::Cursor cursor(automaton);
+        for (std::size_t pos = 0; pos < text.size();) {
+            std::size_t length = 1 + gen() % 5;
+            cursor.Feed(std::string_view(text).substr(pos, length),
+                        [&](std::size_t id, std::size_t end) { found.insert({id, end}); });
+            pos += length;
+        }
+        std::multiset<std::pair<std::size_t, std::size_t>> expected;
+        for (std::size_t id = 0; id < patterns.size(); ++id) {
+            const std::string& pattern = patterns[id];
+            for (std::size_t end = pattern.size(); !pattern.empty() && end <= text.size(); ++end) {
+                if (text.compare(end - pattern.size(), pattern.size(), pattern) == 0) {
+                    expected.insert({id, end});
+                }
+            }
+        }
+        CHECK(found == expected);
+    }
+});
+
+TEST("string/kmp_and_z", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 2000 && !check::Failed(); ++round) {
+        std::string text = MakeText(gen() % 300, round, gen);
+        std::string pattern = MakeText(1 + gen() % 4, round, gen);
+        std::vector<std::size_t> expected;
+        for (std::size_t pos = 0; pos + pattern.size() <= text.size(); ++pos) {
+            if (text.compare(pos, pattern.size(), pattern) == 0) {
+                expected.push_back(pos);
+            }
+        }
+        CHECK(aisd::FindAll(text, pattern) == expected);
+
+        auto z = aisd::ZFunction(text);
+        CHECK_EQ(z.size(), text.size());
+        for (std::size_t i = 0; i < z.size(); ++i) {
+            CHECK_EQ(z[i], NaiveCommonPrefix(text, 0, i));
+        }
+    }
+});
+
+TEST("string/mapped_file", [] {
+    std::mt19937_64 gen(check::Seed());
+    std::string path = check::TempPath("aisd_test_mapped_text.bin");
+    std::string text = MakeText(100000, 1, gen);
+    {
+        auto file = aisd::MappedFile::CreateReadWrite(path, text.size());
+        std::memcpy(file.MutableData(), text.data(), text.size());
+    }
+    auto file = aisd::MappedFile::OpenReadOnly(path);
+    CHECK(file.View() == text);
+
+    // Chunks cover the file in order, and the suffix array of the mapped
+    // bytes matches the in-memory one.
+    std::string joined;
+    file.ForEachChunk(4096 * 3 + 5, [&](std::string_view chunk, std::size_t offset) {
+        CHECK_EQ(offset, joined.size());
+        joined.append(chunk);
+    });
+    CHECK(joined == text);
+    CHECK(aisd::SuffixArray(file.View()) == aisd::SuffixArray(text));
+
+    // Fully out of core: SA, LCP and the LCP scratch all in mapped files.
+    std::size_t n = text.size();
+    std::string array_path = path + ".arrays";
+    {
+        auto arrays = aisd::MappedFile::CreateReadWrite(array_path, (3 * n + 1) * sizeof(std::int64_t));
+        auto* sa = reinterpret_cast<std::int64_t*>(arrays.MutableData());
+        std::int64_t* lcp = sa + n + 1;
+        aisd::BuildSuffixArray(file.View(), sa);
+        aisd::BuildLcpArray(file.View(), sa + 1, lcp, lcp + n);
+        auto expected_sa = aisd::SuffixArray<std::int64_t>(text);
+        auto expected_lcp = aisd::LcpArray(text, expected_sa);
+        CHECK(std::equal(expected_sa.begin(), expected_sa.end(), sa + 1));
+        CHECK(std::equal(expected_lcp.begin(), expected_lcp.end(), lcp));
+    }
+    std::filesystem::remove(array_path);
+    std::filesystem::remove(path);
+
+    bool threw = false;
+    try {
+        aisd::MappedFile::OpenReadOnly(path);
+    } catch (const std::system_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+});
+
+TEST("string/timing", [] {
+    std::mt19937_64 gen(check::Seed());
+    constexpr std::size_t kN = 1 << 20;
+    std::string text = MakeText(kN, 1, gen);
+    std::vector<std::int32_t> sa;
+    std::vector<std::int32_t> expected;
+    double subject = check::TimeMs([&] { sa = aisd::SuffixArray(text); });
+    double reference = check::TimeMs([&] { expected = NaiveSuffixArray(text); });
+    CHECK(sa == expected);
+    check::RecordTiming("string/sa_is vs std_sort_suffixes", kN, subject, reference);
+
+    // 64 dictionary words searched at once vs one std::string::find pass per
+    // word.
+    std::vector<std::string> words(64);
+    aisd::AhoCorasick automaton;
+    for (auto& word : words) {
+        std::size_t pos = gen() % (kN - 8);
+        word = text.substr(pos, 4 + gen() % 4);
+        automaton.AddPattern(word);
+    }
+    automaton.Build();
+    std::size_t subject_matches = 0;
+    std::size_t reference_matches = 0;
+    subject = check::TimeMs([&] {
+        aisd::AhoCorasick::Cursor cursor(automaton);
+        cursor.Feed(text, [&](std::size_t, std::size_t) { ++subject_matches; });
+    });
+    reference = check::TimeMs([&] {
+        for (const auto& word : words) {
+            for (auto pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + 1)) {
+                ++reference_matches;
+            }
+        }
+    });
+    CHECK_EQ(subject_matches, reference_matches);
+    check::RecordTiming("string/aho_corasick_64 vs std_string_find", kN, subject, reference);
+});
+
+}  // namespace
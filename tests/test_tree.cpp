@@ -0,0 +1,263 @@
+#include "check.h"
+
+#include <aisd/tree/btree_set.h>
+#include <aisd/tree/eytzinger_set.h>
+#include <aisd/tree/fenwick_tree.h>
+#include <aisd/tree/segment_tree.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Sorted-vector reference for the order-statistics queries.
+struct NaiveOrder {
+    std::vector<std::uint32_t> keys;  // sorted, unique
+
+    std::size_t Rank(std::uint32_t key) const {
+        return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+    }
+
+    const std::uint32_t* LowerBound(std::uint32_t key) const {
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        return it == keys.end() ? nullptr : &*it;
+    }
+};
+
+bool SameBound(const std::uint32_t* got, const std::uint32_t* expected) {
+    return (got == nullptr) == (expected == nullptr) && (got == nullptr || *got == *expected);
+}
+
+TEST("tree/eytzinger", [] {
+    std::mt19937_64 gen(check::Seed());
+    std::vector<std::size_t> sizes = {0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 1023, 1024, 1025};
+    for (int i = 0; i < 30; ++i) {
+        sizes.push_back(gen() % 5000);
+    }
+    for (std::size_t n : sizes) {
+        std::vector<std::uint32_t> keys(n);
+        for (auto& key : keys) {
+            key = static_cast<std::uint32_t>(gen() % (3 * n + 1));  // duplicates included
+        }
+        aisd::EytzingerSet<std::uint32_t> set(keys);
+        NaiveOrder naive{keys};
+        std::sort(naive.keys.begin(), naive.keys.end());
+        naive.keys.erase(std::unique(naive.keys.begin(), naive.keys.end()), naive.keys.end());
+        CHECK_EQ(set.Size(), naive.keys.size());
+        for (std::size_t rank = 0; rank < naive.keys.size(); ++rank) {
+            CHECK_EQ(set.Select(rank), naive.keys[rank]);
+        }
+        for (int q = 0; q < 200 && !check::Failed(); ++q) {
+            auto key = static_cast<std::uint32_t>(gen() % (3 * n + 3));
+            CHECK_EQ(set.Rank(key), naive.Rank(key));
+            CHECK_EQ(set.Contains(key), std::binary_search(naive.keys.begin(), naive.keys.end(), key));
+            CHECK(SameBound(set.LowerBound(key), naive.LowerBound(key)));
+        }
+    }
+});
+
+// The prefetch stride assumes the node array starts on a cache line.
+template <class Key>
+void CheckEytzingerAlignment() {
+    for (std::size_t n : {0, 1, 5, 100, 4097}) {
+        std::vector<Key> keys(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = static_cast<Key>(i * 7);
+        }
+        aisd::EytzingerSet<Key> set(keys);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(set.Data()) % 64, std::uintptr_t{0});
+    }
+}
+
+TEST("tree/eytzinger_alignment", [] {
+    CheckEytzingerAlignment<std::uint8_t>();
+    CheckEytzingerAlignment<std::uint32_t>();
+    CheckEytzingerAlignment<std::uint64_t>();
+    CheckEytzingerAlignment<double>();
+});
+
+// Insert/erase churn against std::set; order statistics by an O(n) walk.
+template <std::size_t kMinDegree>
+void CheckBTree() {
+    std::mt19937_64 gen(check::Seed());
+    for (int round = 0; round < 20 && !check::Failed(); ++round) {
+        aisd::BTreeSet<std::uint32_t, kMinDegree> tree;
+        std::set<std::uint32_t> reference;
+        std::uint32_t universe = round % 2 == 0 ? 200 : 100000;
+        for (int op = 0; op < 5000 && !check::Failed(); ++op) {
+            auto key = static_cast<std::uint32_t>(gen() % universe);
+            if (gen() % 3 != 0) {
+                CHECK_EQ(tree.Insert(key), reference.insert(key).second);
+            } else {
+                CHECK_EQ(tree.Erase(key), reference.erase(key) == 1);
+            }
+            CHECK_EQ(tree.Size(), reference.size());
+            if (op % 50 != 0) {
+                continue;
+            }
+            auto probe = static_cast<std::uint32_t>(gen() % (universe + 2));
+            auto it = reference.lower_bound(probe);
+            auto rank = static_cast<std::size_t>(std::distance(reference.begin(), it));
+            CHECK_EQ(tree.Rank(probe), rank);
+            CHECK_EQ(tree.Contains(probe), reference.count(probe) == 1);
+            const std::uint32_t* bound = tree.LowerBound(probe);
+            CHECK((bound == nullptr) == (it == reference.end()));
+            CHECK(bound == nullptr || *bound == *it);
+            if (!reference.empty()) {
+                std::size_t select = gen() % reference.size();
+                CHECK_EQ(tree.Select(select), *std::next(reference.begin(), static_cast<std::ptrdiff_t>(select)));
+            }
+            auto high = static_cast<std::uint32_t>(probe + gen() % 100);
+            auto expected = static_cast<std::size_t>(std::distance(it, reference.lower_bound(high)));
+            CHECK_EQ(tree.CountRange(probe, high), expected);
+        }
+    }
+}
+
+TEST("tree/btree", [] {
+    CheckBTree<2>();
+    CheckBTree<3>();
+    CheckBTree<16>();
+});
+
+TEST("tree/fenwick", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : {std::size_t{1}, std::size_t{2}, std::size_t{7}, std::size_t{64}, std::size_t{1000}}) {
+        std::vector<std::int64_t> values(n);
+        for (auto& value : values) {
+            value = static_cast<std::int64_t>(gen() % 10);
+        }
+        aisd::FenwickTree<std::int64_t> tree(values);
+        for (int op = 0; op < 2000 && !check::Failed(); ++op) {
+            std::size_t index = gen() % n;
+            auto delta = static_cast<std::int64_t>(gen() % 10);
+            values[index] += delta;
+            tree.Add(index, delta);
+            std::size_t begin = gen() % (n + 1);
+            std::size_t end = begin + gen() % (n - begin + 1);
+            std::int64_t sum = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                sum += values[i];
+            }
+            CHECK_EQ(tree.RangeSum(begin, end), sum);
+            // LowerBound: first index whose prefix sum reaches target.
+            std::int64_t total = tree.PrefixSum(n);
+            auto target = static_cast<std::int64_t>(gen() % static_cast<std::uint64_t>(total + 2));
+            std::size_t expected = 0;
+            for (std::int64_t prefix = 0; expected < n && prefix + values[expected] < target; ++expected) {
+                prefix += values[expected];
+            }
+            CHECK_EQ(tree.LowerBound(target), expected);
+        }
+    }
+});
+
+// Non-commutative monoid: catches folds that combine out of order.
+struct ConcatMonoid {
+    static std::string Identity() {
+        return {};
+    }
+    std::string operator()(const std::string& a, const std::string& b) const {
+        return a + b;
+    }
+};
+
+template <class Tree, class T, class Fold>
+void CheckSegmentTree(std::mt19937_64& gen, std::vector<T> values, Fold fold, T identity,
+                      const std::function<T()>& random_value) {
+    std::size_t n = values.size();
+    Tree tree(values);
+    for (int op = 0; op < 1500 && !check::Failed(); ++op) {
+        std::size_t index = gen() % n;
+        values[index] = random_value();
+        tree.Set(index, values[index]);
+        std::size_t begin = gen() % (n + 1);
+        std::size_t end = begin + gen() % (n - begin + 1);
+        T expected = identity;
+        for (std::size_t i = begin; i < end; ++i) {
+            expected = fold(expected, values[i]);
+        }
+        CHECK(tree.Query(begin, end) == expected);
+        CHECK(tree.Get(index) == values[index]);
+    }
+}
+
+TEST("tree/segment", [] {
+    std::mt19937_64 gen(check::Seed());
+    for (std::size_t n : {std::size_t{1}, std::size_t{5}, std::size_t{64}, std::size_t{777}}) {
+        std::function<std::int64_t()> number = [&] { return static_cast<std::int64_t>(gen() % 2001) - 1000; };
+        std::vector<std::int64_t> values(n);
+        for (auto& value : values) {
+            value = number();
+        }
+        CheckSegmentTree<aisd::RangeSumTree<std::int64_t>>(
+            gen, values, [](auto a, auto b) { return a + b; }, std::int64_t{0}, number);
+        CheckSegmentTree<aisd::RangeMinTree<std::int64_t>>(
+            gen, values, [](auto a, auto b) { return std::min(a, b); },
+            aisd::MinMonoid<std::int64_t>::Identity(), number);
+        CheckSegmentTree<aisd::RangeMaxTree<std::int64_t>>(
+            gen, values, [](auto a, auto b) { return std::max(a, b); },
+            aisd::MaxMonoid<std::int64_t>::Identity(), number);
+
+        std::function<std::string()> letter = [&] { return std::string(1, static_cast<char>('a' + gen() % 26)); };
+        std::vector<std::string> letters(n);
+        for (auto& value : letters) {
+            value = letter();
+        }
+        CheckSegmentTree<aisd::SegmentTree<std::string, ConcatMonoid>>(
+            gen, letters, [](const auto& a, const auto& b) { return a + b; }, std::string(), letter);
+    }
+});
+
+TEST("tree/timing", [] {
+    std::mt19937_64 gen(check::Seed());
+    constexpr std::size_t kN = 1 << 20;
+    std::vector<std::uint32_t> keys(kN);
+    std::vector<std::uint32_t> queries(kN);
+    for (std::size_t i = 0; i < kN; ++i) {
+        keys[i] = static_cast<std::uint32_t>(gen());
+        queries[i] = static_cast<std::uint32_t>(gen());
+    }
+    aisd::EytzingerSet<std::uint32_t> set(keys);
+    std::vector<std::uint32_t> sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    std::uint64_t subject_sum = 0;
+    std::uint64_t reference_sum = 0;
+    double subject = check::TimeMs([&] {
+        for (auto query : queries) {
+            subject_sum += set.Rank(query);
+        }
+    });
+    double reference = check::TimeMs([&] {
+        for (auto query : queries) {
+            reference_sum += static_cast<std::uint64_t>(std::lower_bound(sorted.begin(), sorted.end(), query) -
+                                                        sorted.begin());
+        }
+    });
+    CHECK_EQ(subject_sum, reference_sum);
+    check::RecordTiming("tree/eytzinger_rank vs std_lower_bound", kN, subject, reference);
+
+    aisd::BTreeSet<std::uint32_t> tree;
+    std::set<std::uint32_t> reference_set;
+    subject = check::TimeMs([&] {
+        for (auto key : keys) {
+            tree.Insert(key);
+        }
+    });
+    reference = check::TimeMs([&] {
+        for (auto key : keys) {
+            reference_set.insert(key);
+        }
+    });
+    CHECK_EQ(tree.Size(), reference_set.size());
+    check::RecordTiming("tree/btree_insert vs std_set", kN, subject, reference);
+});
+
+}  // namespace